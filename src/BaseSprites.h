@@ -48,6 +48,8 @@ public:
         return mDepth;
     }
 
+    virtual bool IsUpdatable() const override { return false; }
+
     virtual void draw(sf::RenderTarget& target, const sf::RenderStates& states) const
     {
         sf::RenderStates statesCopy(states);
@@ -57,12 +59,23 @@ public:
 
     void SetTexture(const sf::Texture& texture, bool resetRect)
     {
+        // Animations set their frame every update, the bounds only go stale when the frame changes
+        const sf::Texture* previousTexture = &mSprite.getTexture();
+        sf::IntRect previousRect = mSprite.getTextureRect();
         mSprite.setTexture(texture, resetRect);
+        if (previousTexture != &texture || mSprite.getTextureRect() != previousRect)
+        {
+            InvalidateBounds();
+        }
     }
 
     void SetTextureRegion(const sf::IntRect& region)
     {
-        mSprite.setTextureRect(region);
+        if (region != mSprite.getTextureRect())
+        {
+            mSprite.setTextureRect(region);
+            InvalidateBounds();
+        }
     }
 
     void FlipHort(bool flag)
@@ -102,6 +115,8 @@ public:
         SetScale(scale);
     }
 
+    virtual bool IsUpdatable() const override { return true; }
+
     bool UpdateAnimation(const sf::Time& timeslice)
     {
         bool isRestarted = mAnimation.Update(timeslice);
@@ -0,0 +1,35 @@
+#pragma once
+
+// Includes
+//------------------------------------------------------------------------------
+// System
+#include <cstddef>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Read-only view of elements owned elsewhere, such as a vector or a mapped file
+template<typename T>
+class ArrayView
+{
+public:
+    ArrayView() = default;
+    ArrayView(const T* data, size_t size)
+        : mData(data)
+        , mSize(size)
+    { }
+    ArrayView(const std::vector<T>& values)
+        : mData(values.data())
+        , mSize(values.size())
+    { }
+
+    const T& operator[](size_t index) const { return mData[index]; }
+    const T* begin() const { return mData; }
+    const T* end() const { return mData + mSize; }
+    const T* data() const { return mData; }
+    size_t size() const { return mSize; }
+    bool empty() const { return mSize == 0; }
+
+private:
+    const T* mData = nullptr;
+    size_t mSize = 0;
+};
\ No newline at end of file
@@ -0,0 +1,147 @@
+#pragma once
+
+// Includes
+//------------------------------------------------------------------------------
+// Core
+#include "ArrayView.h"
+
+// System
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+//------------------------------------------------------------------------------
+class BinaryWriter
+{
+public:
+    template<typename T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Type must be trivially copyable");
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void WriteString(const std::string& value)
+    {
+        Write(static_cast<uint32_t>(value.size()));
+        WriteBytes(value.data(), value.size());
+    }
+
+    // Elements are aligned from the start of the data so a reader can view them in place
+    template<typename T>
+    void WriteArray(const ArrayView<T>& values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Type must be trivially copyable");
+        Write(static_cast<uint32_t>(values.size()));
+        mBuffer.resize((mBuffer.size() + alignof(T) - 1) / alignof(T) * alignof(T), 0);
+        WriteBytes(values.data(), values.size() * sizeof(T));
+    }
+
+    void SaveToFile(const fs::path& filepath) const
+    {
+        std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char*>(mBuffer.data()), mBuffer.size()))
+        {
+            throw std::runtime_error("Failed to write file: " + filepath.string());
+        }
+    }
+
+private:
+    void WriteBytes(const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        mBuffer.insert(mBuffer.end(), bytes, bytes + size);
+    }
+
+    std::vector<uint8_t> mBuffer;
+};
+
+//------------------------------------------------------------------------------
+class BinaryReader
+{
+public:
+    BinaryReader(const uint8_t* data, size_t size)
+        : mData(data)
+        , mSize(size)
+        , mOffset(0)
+    { }
+
+    template<typename T>
+    T Read()
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Type must be trivially copyable");
+        T value;
+        ReadBytes(&value, sizeof(T));
+        return value;
+    }
+
+    std::string ReadString()
+    {
+        uint32_t size = Read<uint32_t>();
+        Require(size);
+        std::string value(reinterpret_cast<const char*>(mData + mOffset), size);
+        mOffset += size;
+        return value;
+    }
+
+    // Views the elements in place, the data must outlive the view
+    template<typename T>
+    ArrayView<T> ReadArrayView()
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Type must be trivially copyable");
+        uint32_t count = Read<uint32_t>();
+        Skip((alignof(T) - mOffset % alignof(T)) % alignof(T));
+        Require(static_cast<size_t>(count) * sizeof(T));
+        if (reinterpret_cast<uintptr_t>(mData + mOffset) % alignof(T) != 0)
+        {
+            throw std::runtime_error("Misaligned array in binary data");
+        }
+
+        ArrayView<T> values(reinterpret_cast<const T*>(mData + mOffset), count);
+        mOffset += static_cast<size_t>(count) * sizeof(T);
+        return values;
+    }
+
+    // Element count of a following sequence, rejected early when the elements cannot fit in the data left
+    uint32_t ReadCount(size_t minElementSize)
+    {
+        uint32_t count = Read<uint32_t>();
+        Require(static_cast<size_t>(count) * minElementSize);
+        return count;
+    }
+
+    bool IsAtEnd() const { return mOffset == mSize; }
+
+private:
+    void ReadBytes(void* data, size_t size)
+    {
+        Require(size);
+        std::memcpy(data, mData + mOffset, size);
+        mOffset += size;
+    }
+
+    void Skip(size_t size)
+    {
+        Require(size);
+        mOffset += size;
+    }
+
+    void Require(size_t size) const
+    {
+        if (size > mSize - mOffset)
+        {
+            throw std::runtime_error("Unexpected end of binary data");
+        }
+    }
+
+    const uint8_t* mData;
+    size_t mSize;
+    size_t mOffset;
+};
@@ -0,0 +1,132 @@
+// Includes
+//------------------------------------------------------------------------------
+// Core
+#include "Bitmask.h"
+
+// System
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BITMASK_USE_SSE2
+#endif
+
+//------------------------------------------------------------------------------
+Bitmask::Bitmask(const sf::Image& image, const sf::IntRect& region)
+    : mSize(region.getSize())
+    , mRowWords((mSize.x + 63) / 64)
+    , mBits(static_cast<size_t>(mRowWords) * mSize.y, 0)
+{
+    for (uint32_t y = 0; y < mSize.y; y++)
+    {
+        for (uint32_t x = 0; x < mSize.x; x++)
+        {
+            sf::Vector2u pixelPos(region.left + x, region.top + y);
+            if (image.getPixel(pixelPos).a != 0)
+            {
+                mBits[y * mRowWords + (x >> 6)] |= uint64_t(1) << (x & 63);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void Bitmask::ExtractRow(uint32_t y, int32_t firstBit, uint32_t wordCount, uint64_t* words) const
+{
+    // Realigns the row so bit firstBit lands on bit 0, bits outside the mask read as zero
+    const uint64_t* row = GetRow(y);
+    int32_t wordOffset = firstBit >= 0 ? firstBit / 64 : -((63 - firstBit) / 64);
+    uint32_t shift = static_cast<uint32_t>(firstBit - wordOffset * 64);
+
+    auto readWord = [&](int32_t index) -> uint64_t
+    {
+        return index >= 0 && index < static_cast<int32_t>(mRowWords) ? row[index] : 0;
+    };
+
+    for (uint32_t i = 0; i < wordCount; i++)
+    {
+        int32_t index = wordOffset + static_cast<int32_t>(i);
+        uint64_t word = readWord(index) >> shift;
+        if (shift != 0)
+        {
+            word |= readWord(index + 1) << (64 - shift);
+        }
+        words[i] = word;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool IsAnyBitShared(const uint64_t* words1, const uint64_t* words2, size_t wordCount)
+{
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    for (; i + 4 <= wordCount; i += 4)
+    {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words1 + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words2 + i));
+        if (!_mm256_testz_si256(a, b))
+        {
+            return true;
+        }
+    }
+#elif defined(BITMASK_USE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 2 <= wordCount; i += 2)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words1 + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words2 + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(a, b), zero)) != 0xFFFF)
+        {
+            return true;
+        }
+    }
+#endif
+
+    for (; i < wordCount; i++)
+    {
+        if (words1[i] & words2[i])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+/*static*/ BitmaskCache& BitmaskCache::Instance()
+{
+    static BitmaskCache cache;
+    return cache;
+}
+
+//------------------------------------------------------------------------------
+const Bitmask& BitmaskCache::GetBitmask(const sf::Texture& texture, const sf::IntRect& region)
+{
+    Key key{ &texture, region };
+    auto itr = mBitmasks.find(key);
+    if (itr != mBitmasks.end())
+    {
+        return itr->second;
+    }
+
+    // One readback of the source texture per mask, never repeated for the same region
+    sf::Image image = texture.copyToImage();
+    return mBitmasks.emplace(key, Bitmask(image, region)).first->second;
+}
+
+//------------------------------------------------------------------------------
+void BitmaskCache::Evict(const sf::Texture& texture)
+{
+    for (auto itr = mBitmasks.begin(); itr != mBitmasks.end(); )
+    {
+        if (itr->first.mTexture == &texture)
+        {
+            itr = mBitmasks.erase(itr);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+// Includes
+//------------------------------------------------------------------------------
+// Third party
+#include <SFML/Graphics.hpp>
+
+// System
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+//------------------------------------------------------------------------------
+class Bitmask
+{
+public:
+    Bitmask() = default;
+    Bitmask(const sf::Image& image, const sf::IntRect& region);
+
+    bool IsSolid(int32_t x, int32_t y) const
+    {
+        if (x < 0 || y < 0 || x >= static_cast<int32_t>(mSize.x) || y >= static_cast<int32_t>(mSize.y))
+        {
+            return false;
+        }
+        return (mBits[y * mRowWords + (x >> 6)] >> (x & 63)) & 1;
+    }
+
+    // Bit x of a row is stored at word x / 64, bit x % 64
+    const uint64_t* GetRow(uint32_t y) const { return &mBits[y * mRowWords]; }
+    void ExtractRow(uint32_t y, int32_t firstBit, uint32_t wordCount, uint64_t* words) const;
+    uint32_t GetRowWords() const { return mRowWords; }
+    const sf::Vector2u& GetSize() const { return mSize; }
+
+private:
+    sf::Vector2u mSize;
+    uint32_t mRowWords = 0;
+    std::vector<uint64_t> mBits;
+};
+
+//------------------------------------------------------------------------------
+bool IsAnyBitShared(const uint64_t* words1, const uint64_t* words2, size_t wordCount);
+
+//------------------------------------------------------------------------------
+class BitmaskCache
+{
+public:
+    BitmaskCache(const BitmaskCache&) = delete;
+    BitmaskCache& operator=(const BitmaskCache&) = delete;
+
+    static BitmaskCache& Instance();
+
+    // Builds the mask on first request, preload at level load to keep readbacks out of gameplay
+    const Bitmask& GetBitmask(const sf::Texture& texture, const sf::IntRect& region);
+    void Preload(const sf::Texture& texture, const sf::IntRect& region) { GetBitmask(texture, region); }
+
+    // Texture addresses are reused after unloading, evict or clear when textures are released
+    void Evict(const sf::Texture& texture);
+    void Clear() { mBitmasks.clear(); }
+    size_t Count() const { return mBitmasks.size(); }
+
+private:
+    BitmaskCache() = default;
+
+    struct Key
+    {
+        const sf::Texture* mTexture;
+        sf::IntRect mRegion;
+
+        bool operator==(const Key& other) const { return mTexture == other.mTexture && mRegion == other.mRegion; }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            size_t hash = std::hash<const sf::Texture*>()(key.mTexture);
+            for (int32_t value : { key.mRegion.left, key.mRegion.top, key.mRegion.width, key.mRegion.height })
+            {
+                hash ^= std::hash<int32_t>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            }
+            return hash;
+        }
+    };
+
+    std::unordered_map<Key, Bitmask, KeyHash> mBitmasks;
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+// Includes
+//------------------------------------------------------------------------------
+// Core
+#include "GameObjectManager.h"
+
+// System
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+//------------------------------------------------------------------------------
+// Members keep the order they were added in
+struct DrawOrderByInsertion
+{
+    using KeyType = uint32_t;
+
+    static KeyType GetKey(const GameObject& obj, uint32_t sequence) { return sequence; }
+};
+
+//------------------------------------------------------------------------------
+// Draw list kept sorted on insert and remove, members are held by entity id so objects freed
+// by the manager between refreshes are never dereferenced
+template<typename Order>
+class DrawList
+{
+public:
+    using KeyType = typename Order::KeyType;
+
+    void Add(GameObject* obj)
+    {
+        Entry entry{ Order::GetKey(*obj, mNextSequence++), obj->GetEntityId() };
+        mEntries.insert(std::upper_bound(mEntries.begin(), mEntries.end(), entry, IsKeyLess), entry);
+    }
+
+    // Drops members killed since the last refresh, the rest keep their place
+    void Refresh()
+    {
+        GameObjectManager& gameObjectManager = GameObjectManager::Instance();
+        mEntries.erase(std::remove_if(mEntries.begin(), mEntries.end(), [&gameObjectManager](const Entry& entry)
+        {
+            GameObject* obj = gameObjectManager.GetInstance(entry.mEntityId);
+            return obj == nullptr || obj->IsMarkedForRemoval();
+        }), mEntries.end());
+    }
+
+    template<typename Callback>
+    void ForEach(Callback callback) const
+    {
+        // Members killed after the refresh are skipped until the next one removes them
+        GameObjectManager& gameObjectManager = GameObjectManager::Instance();
+        for (const Entry& entry : mEntries)
+        {
+            GameObject* obj = gameObjectManager.GetInstance(entry.mEntityId);
+            if (obj != nullptr && !obj->IsMarkedForRemoval())
+            {
+                callback(obj);
+            }
+        }
+    }
+
+    size_t Count() const { return mEntries.size(); }
+
+private:
+    struct Entry
+    {
+        KeyType mKey;
+        uint32_t mEntityId;
+    };
+
+    static bool IsKeyLess(const Entry& entry0, const Entry& entry1) { return entry0.mKey < entry1.mKey; }
+
+    std::vector<Entry> mEntries;
+    uint32_t mNextSequence = 0;
+};
\ No newline at end of file
@@ -0,0 +1,379 @@
+// Includes
+//------------------------------------------------------------------------------
+// Core
+#include "DynamicAabbTree.h"
+
+// System
+#include <cmath>
+
+//------------------------------------------------------------------------------
+DynamicAabbTree::DynamicAabbTree(float fatMargin)
+    : mRoot(NULL_NODE)
+    , mFreeList(NULL_NODE)
+    , mFatMargin(fatMargin)
+{
+}
+
+//------------------------------------------------------------------------------
+void DynamicAabbTree::Insert(GameObject* obj, const FloatRect& bounds)
+{
+    if (mProxies.find(obj) != mProxies.end())
+    {
+        Update(obj, bounds);
+        return;
+    }
+
+    int32_t leaf = AllocateNode();
+    mNodes[leaf].mAabb = Fatten(bounds);
+    mNodes[leaf].mObject = obj;
+    mNodes[leaf].mHeight = 0;
+
+    InsertLeaf(leaf);
+    mProxies.emplace(obj, leaf);
+}
+
+//------------------------------------------------------------------------------
+void DynamicAabbTree::Remove(GameObject* obj)
+{
+    auto itr = mProxies.find(obj);
+    if (itr != mProxies.end())
+    {
+        RemoveLeaf(itr->second);
+        FreeNode(itr->second);
+        mProxies.erase(itr);
+    }
+}
+
+//------------------------------------------------------------------------------
+void DynamicAabbTree::Update(GameObject* obj, const FloatRect& bounds)
+{
+    auto itr = mProxies.find(obj);
+    if (itr == mProxies.end())
+    {
+        return;
+    }
+
+    // Still inside the fat bounds, the tree is left untouched
+    int32_t leaf = itr->second;
+    if (IsContaining(mNodes[leaf].mAabb, bounds))
+    {
+        return;
+    }
+
+    RemoveLeaf(leaf);
+    mNodes[leaf].mAabb = Fatten(bounds);
+    InsertLeaf(leaf);
+}
+
+//------------------------------------------------------------------------------
+void DynamicAabbTree::Clear()
+{
+    mNodes.clear();
+    mProxies.clear();
+    mRoot = NULL_NODE;
+    mFreeList = NULL_NODE;
+}
+
+//------------------------------------------------------------------------------
+void DynamicAabbTree::QueryAABB(const FloatRect& area, std::vector<GameObject*>& result) const
+{
+    std::vector<int32_t> stack;
+    VisitOverlaps(area, stack, [&](int32_t leaf)
+    {
+        result.push_back(mNodes[leaf].mObject);
+    });
+}
+
+//------------------------------------------------------------------------------
+bool DynamicAabbTree::IntersectSegment(const FloatRect& aabb, const sf::Vector2f& from, const sf::Vector2f& to, 
+                                       float maxFraction, float& entryFraction)
+{
+    // Slab test clipped to [0, maxFraction] of the segment
+    float minT = 0.0f;
+    float maxT = maxFraction;
+    const float origin[2] = { from.x, from.y };
+    const float delta[2] = { to.x - from.x, to.y - from.y };
+    const float slabMin[2] = { aabb.GetLeft(), aabb.GetTop() };
+    const float slabMax[2] = { aabb.GetRight(), aabb.GetBottom() };
+
+    for (int32_t axis = 0; axis < 2; axis++)
+    {
+        if (std::abs(delta[axis]) < 1e-6f)
+        {
+            if (origin[axis] < slabMin[axis] || origin[axis] > slabMax[axis])
+            {
+                return false;
+            }
+            continue;
+        }
+
+        float t1 = (slabMin[axis] - origin[axis]) / delta[axis];
+        float t2 = (slabMax[axis] - origin[axis]) / delta[axis];
+        minT = std::max(minT, std::min(t1, t2));
+        maxT = std::min(maxT, std::max(t1, t2));
+        if (minT > maxT)
+        {
+            return false;
+        }
+    }
+
+    entryFraction = minT;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+int32_t DynamicAabbTree::AllocateNode()
+{
+    if (mFreeList == NULL_NODE)
+    {
+        mNodes.emplace_back();
+        return static_cast<int32_t>(mNodes.size()) - 1;
+    }
+
+    int32_t nodeId = mFreeList;
+    mFreeList = mNodes[nodeId].mParent;
+    mNodes[nodeId] = Node();
+    return nodeId;
+}
+
+//------------------------------------------------------------------------------
+void DynamicAabbTree::FreeNode(int32_t nodeId)
+{
+    // Free nodes are chained through their parent link
+    mNodes[nodeId].mParent = mFreeList;
+    mNodes[nodeId].mObject = nullptr;
+    mNodes[nodeId].mHeight = -1;
+    mFreeList = nodeId;
+}
+
+//------------------------------------------------------------------------------
+void DynamicAabbTree::InsertLeaf(int32_t leaf)
+{
+    if (mRoot == NULL_NODE)
+    {
+        mRoot = leaf;
+        mNodes[leaf].mParent = NULL_NODE;
+        return;
+    }
+
+    // Descend towards the sibling with the lowest surface area increase
+    FloatRect leafAabb = mNodes[leaf].mAabb;
+    int32_t index = mRoot;
+    while (!mNodes[index].IsLeaf())
+    {
+        const Node& node = mNodes[index];
+        float perimeter = GetPerimeter(node.mAabb);
+        float combinedPerimeter = GetPerimeter(Combine(node.mAabb, leafAabb));
+
+        // Cost of pairing with this node versus pushing the leaf further down
+        float cost = 2.0f * combinedPerimeter;
+        float inheritanceCost = 2.0f * (combinedPerimeter - perimeter);
+
+        auto getChildCost = [&](int32_t child)
+        {
+            float childCombined = GetPerimeter(Combine(mNodes[child].mAabb, leafAabb));
+            if (mNodes[child].IsLeaf())
+            {
+                return childCombined + inheritanceCost;
+            }
+            return childCombined - GetPerimeter(mNodes[child].mAabb) + inheritanceCost;
+        };
+
+        float cost1 = getChildCost(node.mChild1);
+        float cost2 = getChildCost(node.mChild2);
+        if (cost < cost1 && cost < cost2)
+        {
+            break;
+        }
+        index = cost1 < cost2 ? node.mChild1 : node.mChild2;
+    }
+
+    int32_t sibling = index;
+    int32_t oldParent = mNodes[sibling].mParent;
+    int32_t newParent = AllocateNode();
+    mNodes[newParent].mParent = oldParent;
+    mNodes[newParent].mAabb = Combine(leafAabb, mNodes[sibling].mAabb);
+    mNodes[newParent].mHeight = mNodes[sibling].mHeight + 1;
+    mNodes[newParent].mChild1 = sibling;
+    mNodes[newParent].mChild2 = leaf;
+    mNodes[sibling].mParent = newParent;
+    mNodes[leaf].mParent = newParent;
+
+    if (oldParent == NULL_NODE)
+    {
+        mRoot = newParent;
+    }
+    else if (mNodes[oldParent].mChild1 == sibling)
+    {
+        mNodes[oldParent].mChild1 = newParent;
+    }
+    else
+    {
+        mNodes[oldParent].mChild2 = newParent;
+    }
+
+    Refit(mNodes[leaf].mParent);
+}
+
+//------------------------------------------------------------------------------
+void DynamicAabbTree::RemoveLeaf(int32_t leaf)
+{
+    if (leaf == mRoot)
+    {
+        mRoot = NULL_NODE;
+        return;
+    }
+
+    int32_t parent = mNodes[leaf].mParent;
+    int32_t grandParent = mNodes[parent].mParent;
+    int32_t sibling = mNodes[parent].mChild1 == leaf ? mNodes[parent].mChild2 : mNodes[parent].mChild1;
+
+    // The sibling takes the parent's place
+    mNodes[sibling].mParent = grandParent;
+    if (grandParent == NULL_NODE)
+    {
+        mRoot = sibling;
+    }
+    else
+    {
+        if (mNodes[grandParent].mChild1 == parent)
+        {
+            mNodes[grandParent].mChild1 = sibling;
+        }
+        else
+        {
+            mNodes[grandParent].mChild2 = sibling;
+        }
+    }
+
+    FreeNode(parent);
+    Refit(grandParent);
+}
+
+//------------------------------------------------------------------------------
+void DynamicAabbTree::Refit(int32_t nodeId)
+{
+    // Walk back to the root rebalancing and tightening each ancestor
+    while (nodeId != NULL_NODE)
+    {
+        nodeId = Balance(nodeId);
+
+        Node& node = mNodes[nodeId];
+        const Node& child1 = mNodes[node.mChild1];
+        const Node& child2 = mNodes[node.mChild2];
+        node.mHeight = 1 + std::max(child1.mHeight, child2.mHeight);
+        node.mAabb = Combine(child1.mAabb, child2.mAabb);
+
+        nodeId = node.mParent;
+    }
+}
+
+//------------------------------------------------------------------------------
+int32_t DynamicAabbTree::Balance(int32_t nodeId)
+{
+    const Node& node = mNodes[nodeId];
+    if (node.IsLeaf() || node.mHeight < 2)
+    {
+        return nodeId;
+    }
+
+    int32_t child1 = node.mChild1;
+    int32_t child2 = node.mChild2;
+    int32_t balance = mNodes[child2].mHeight - mNodes[child1].mHeight;
+
+    if (balance > 1)
+    {
+        return Rotate(nodeId, child2, child1);
+    }
+    if (balance < -1)
+    {
+        return Rotate(nodeId, child1, child2);
+    }
+    return nodeId;
+}
+
+//------------------------------------------------------------------------------
+int32_t DynamicAabbTree::Rotate(int32_t parentId, int32_t childId, int32_t siblingId)
+{
+    // Lifts the taller child above its parent, the parent adopts the child's shorter subtree
+    Node& parent = mNodes[parentId];
+    Node& child = mNodes[childId];
+    const Node& sibling = mNodes[siblingId];
+
+    int32_t grandChild1 = child.mChild1;
+    int32_t grandChild2 = child.mChild2;
+    int32_t keep = mNodes[grandChild1].mHeight > mNodes[grandChild2].mHeight ? grandChild1 : grandChild2;
+    int32_t move = keep == grandChild1 ? grandChild2 : grandChild1;
+
+    child.mChild1 = parentId;
+    child.mChild2 = keep;
+    child.mParent = parent.mParent;
+    parent.mParent = childId;
+
+    if (child.mParent == NULL_NODE)
+    {
+        mRoot = childId;
+    }
+    else if (mNodes[child.mParent].mChild1 == parentId)
+    {
+        mNodes[child.mParent].mChild1 = childId;
+    }
+    else
+    {
+        mNodes[child.mParent].mChild2 = childId;
+    }
+
+    if (parent.mChild1 == childId)
+    {
+        parent.mChild1 = move;
+    }
+    else
+    {
+        parent.mChild2 = move;
+    }
+    mNodes[move].mParent = parentId;
+
+    parent.mAabb = Combine(sibling.mAabb, mNodes[move].mAabb);
+    parent.mHeight = 1 + std::max(sibling.mHeight, mNodes[move].mHeight);
+    child.mAabb = Combine(parent.mAabb, mNodes[keep].mAabb);
+    child.mHeight = 1 + std::max(parent.mHeight, mNodes[keep].mHeight);
+
+    return childId;
+}
+
+//------------------------------------------------------------------------------
+FloatRect DynamicAabbTree::Fatten(const FloatRect& bounds) const
+{
+    return FloatRect({ bounds.GetLeft() - mFatMargin, bounds.GetTop() - mFatMargin },
+                     { bounds.GetWidth() + mFatMargin * 2.0f, bounds.GetHeight() + mFatMargin * 2.0f });
+}
+
+//------------------------------------------------------------------------------
+FloatRect DynamicAabbTree::Combine(const FloatRect& a, const FloatRect& b)
+{
+    float left = std::min(a.GetLeft(), b.GetLeft());
+    float top = std::min(a.GetTop(), b.GetTop());
+    float right = std::max(a.GetRight(), b.GetRight());
+    float bottom = std::max(a.GetBottom(), b.GetBottom());
+    return FloatRect({ left, top }, { right - left, bottom - top });
+}
+
+//------------------------------------------------------------------------------
+float DynamicAabbTree::GetPerimeter(const FloatRect& aabb)
+{
+    return 2.0f * (aabb.GetWidth() + aabb.GetHeight());
+}
+
+//------------------------------------------------------------------------------
+bool DynamicAabbTree::IsContaining(const FloatRect& outer, const FloatRect& inner)
+{
+    return outer.GetLeft() <= inner.GetLeft() && outer.GetTop() <= inner.GetTop() &&
+           outer.GetRight() >= inner.GetRight() && outer.GetBottom() >= inner.GetBottom();
+}
+
+//------------------------------------------------------------------------------
+bool DynamicAabbTree::IsOverlapping(const FloatRect& a, const FloatRect& b)
+{
+    return a.GetLeft() <= b.GetRight() && b.GetLeft() <= a.GetRight() &&
+           a.GetTop() <= b.GetBottom() && b.GetTop() <= a.GetBottom();
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+// Includes
+//------------------------------------------------------------------------------
+// Third party
+#include <SFML/Graphics.hpp>
+
+// Core
+#include "FloatRect.h"
+
+// System
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+// Forward declarations
+//------------------------------------------------------------------------------
+class GameObject;
+
+//------------------------------------------------------------------------------
+struct RayHit
+{
+    GameObject* mObject;
+    float mFraction;
+};
+
+//------------------------------------------------------------------------------
+class DynamicAabbTree
+{
+    static constexpr int32_t NULL_NODE = -1;
+
+    struct Node
+    {
+        FloatRect mAabb;
+        GameObject* mObject = nullptr;
+        int32_t mParent = NULL_NODE;
+        int32_t mChild1 = NULL_NODE;
+        int32_t mChild2 = NULL_NODE;
+        int32_t mHeight = 0;    // Leaf = 0, free node = -1
+
+        bool IsLeaf() const { return mChild1 == NULL_NODE; }
+    };
+
+public:
+    explicit DynamicAabbTree(float fatMargin);
+
+    // Leaves store the bounds grown by the fat margin so small moves need no tree update
+    void Insert(GameObject* obj, const FloatRect& bounds);
+    void Remove(GameObject* obj);
+    void Update(GameObject* obj, const FloatRect& bounds);
+    void Clear();
+
+    // Appends every object whose fat bounds overlap the area
+    void QueryAABB(const FloatRect& area, std::vector<GameObject*>& result) const;
+
+    // Calls callback(GameObject*, GameObject*) once for each pair of overlapping fat bounds
+    template<typename Callback>
+    void QueryOverlapPairs(Callback callback) const
+    {
+        std::vector<int32_t> stack;
+        for (const auto& [obj, leaf] : mProxies)
+        {
+            const FloatRect& aabb = mNodes[leaf].mAabb;
+            VisitOverlaps(aabb, stack, [&](int32_t other)
+            {
+                // Each unordered pair is reported once
+                if (other > leaf)
+                {
+                    callback(obj, mNodes[other].mObject);
+                }
+            });
+        }
+    }
+
+    // Calls callback(GameObject*, float entryFraction) for objects whose fat bounds the segment crosses,
+    // the callback returns a new clip fraction to shorten the ray or 1.0f to keep it
+    template<typename Callback>
+    void RayCast(const sf::Vector2f& from, const sf::Vector2f& to, Callback callback) const
+    {
+        if (mRoot == NULL_NODE)
+        {
+            return;
+        }
+
+        float maxFraction = 1.0f;
+        std::vector<int32_t> stack{ mRoot };
+        while (!stack.empty())
+        {
+            int32_t nodeId = stack.back();
+            stack.pop_back();
+
+            const Node& node = mNodes[nodeId];
+            float entryFraction = 0.0f;
+            if (!IntersectSegment(node.mAabb, from, to, maxFraction, entryFraction))
+            {
+                continue;
+            }
+
+            if (node.IsLeaf())
+            {
+                maxFraction = std::min(maxFraction, callback(node.mObject, entryFraction));
+                if (maxFraction <= 0.0f)
+                {
+                    return;
+                }
+            }
+            else
+            {
+                stack.push_back(node.mChild1);
+                stack.push_back(node.mChild2);
+            }
+        }
+    }
+
+    int32_t GetHeight() const { return mRoot == NULL_NODE ? 0 : mNodes[mRoot].mHeight; }
+    size_t Count() const { return mProxies.size(); }
+
+    static bool IntersectSegment(const FloatRect& aabb, const sf::Vector2f& from, const sf::Vector2f& to, 
+                                 float maxFraction, float& entryFraction);
+
+private:
+    template<typename Visitor>
+    void VisitOverlaps(const FloatRect& area, std::vector<int32_t>& stack, Visitor visitor) const
+    {
+        if (mRoot == NULL_NODE)
+        {
+            return;
+        }
+
+        stack.clear();
+        stack.push_back(mRoot);
+        while (!stack.empty())
+        {
+            int32_t nodeId = stack.back();
+            stack.pop_back();
+
+            const Node& node = mNodes[nodeId];
+            if (!IsOverlapping(node.mAabb, area))
+            {
+                continue;
+            }
+
+            if (node.IsLeaf())
+            {
+                visitor(nodeId);
+            }
+            else
+            {
+                stack.push_back(node.mChild1);
+                stack.push_back(node.mChild2);
+            }
+        }
+    }
+
+    int32_t AllocateNode();
+    void FreeNode(int32_t nodeId);
+    void InsertLeaf(int32_t leaf);
+    void RemoveLeaf(int32_t leaf);
+    void Refit(int32_t nodeId);
+    int32_t Balance(int32_t nodeId);
+    int32_t Rotate(int32_t parentId, int32_t childId, int32_t siblingId);
+
+    FloatRect Fatten(const FloatRect& bounds) const;
+
+    static FloatRect Combine(const FloatRect& a, const FloatRect& b);
+    static float GetPerimeter(const FloatRect& aabb);
+    static bool IsContaining(const FloatRect& outer, const FloatRect& inner);
+    static bool IsOverlapping(const FloatRect& a, const FloatRect& b);
+
+    std::vector<Node> mNodes;
+    std::unordered_map<GameObject*, int32_t> mProxies;
+    int32_t mRoot;
+    int32_t mFreeList;
+    float mFatMargin;
+};
@@ -28,7 +28,7 @@ public:
         return mRectangle.findIntersection(rectangle);
     }
 
-    bool ContainsPoint(const sf::Vector2f& point)
+    bool ContainsPoint(const sf::Vector2f& point) const
     {
         return mRectangle.contains(point);
     }
@@ -12,17 +12,17 @@
 void GameObject::Kill()
 {
     mIsMarkedForRemoval = true;
-    for (auto group : mTrackedGroups)
+    for (uint64_t groupMask = mGroupMask; groupMask != 0; groupMask &= groupMask - 1)
     {
-        group->RemoveGameObject(this);
+        Group::GetGroupById(GetLowestBitIndex(groupMask))->RemoveGameObject(this);
     }
-    mTrackedGroups.clear();
+    mGroupMask = 0;
 }
 
 //------------------------------------------------------------------------------
 void GameObject::TrackGroupMembership(Group* group)
 {
-    mTrackedGroups.insert(group);
+    mGroupMask |= uint64_t(1) << group->GetId();
 }
 
 //------------------------------------------------------------------------------
@@ -30,50 +30,63 @@ void GameObject::UntrackGroupMembership(Group* group)
 {
     if (!mIsMarkedForRemoval)
     {
-        mTrackedGroups.erase(group);
+        mGroupMask &= ~(uint64_t(1) << group->GetId());
     }
 }
 
 //------------------------------------------------------------------------------
-bool GameObject::IsDownCollision(const GameObject& other) const
+void GameObject::NotifyHitboxChanged()
 {
-    FloatRect hitbox0 = GetHitbox();
-    FloatRect previousHitbox0 = GetPreviousHitbox();
-    FloatRect hitbox1 = other.GetHitbox();
-    FloatRect previousHitbox1 = other.GetPreviousHitbox();
+    for (uint64_t groupMask = mGroupMask; groupMask != 0; groupMask &= groupMask - 1)
+    {
+        Group::GetGroupById(GetLowestBitIndex(groupMask))->UpdateBroadphase(this);
+    }
+}
 
-    return hitbox0.GetBottom() >= hitbox1.GetTop() && previousHitbox0.GetBottom() <= previousHitbox1.GetTop();
+//------------------------------------------------------------------------------
+bool GameObject::IsDownCollision(const GameObject& other) const
+{
+    return IsDownCollision(GetHitbox(), GetPreviousHitbox(), other.GetHitbox(), other.GetPreviousHitbox());
 }
 
 //------------------------------------------------------------------------------
 bool GameObject::IsUpCollision(const GameObject& other) const
 {
-    FloatRect hitbox0 = GetHitbox();
-    FloatRect previousHitbox0 = GetPreviousHitbox();
-    FloatRect hitbox1 = other.GetHitbox();
-    FloatRect previousHitbox1 = other.GetPreviousHitbox();
-
-    return hitbox0.GetTop() <= hitbox1.GetBottom() && previousHitbox0.GetTop() >= previousHitbox1.GetBottom();
+    return IsUpCollision(GetHitbox(), GetPreviousHitbox(), other.GetHitbox(), other.GetPreviousHitbox());
 }
 
 //------------------------------------------------------------------------------
 bool GameObject::IsLeftCollision(const GameObject& other) const
 {
-    FloatRect hitbox0 = GetHitbox();
-    FloatRect previousHitbox0 = GetPreviousHitbox();
-    FloatRect hitbox1 = other.GetHitbox();
-    FloatRect previousHitbox1 = other.GetPreviousHitbox();
-
-    return hitbox0.GetLeft() <= hitbox1.GetRight() && previousHitbox0.GetLeft() >= previousHitbox1.GetRight();
+    return IsLeftCollision(GetHitbox(), GetPreviousHitbox(), other.GetHitbox(), other.GetPreviousHitbox());
 }
 
 //------------------------------------------------------------------------------
 bool GameObject::IsRightCollision(const GameObject& other) const
 {
-    FloatRect hitbox0 = GetHitbox();
-    FloatRect previousHitbox0 = GetPreviousHitbox();
-    FloatRect hitbox1 = other.GetHitbox();
-    FloatRect previousHitbox1 = other.GetPreviousHitbox();
+    return IsRightCollision(GetHitbox(), GetPreviousHitbox(), other.GetHitbox(), other.GetPreviousHitbox());
+}
+
+//------------------------------------------------------------------------------
+bool GameObject::IsDownCollision(const FloatRect& hitbox0, const FloatRect& previousHitbox0, const FloatRect& hitbox1, const FloatRect& previousHitbox1)
+{
+    return hitbox0.GetBottom() >= hitbox1.GetTop() && previousHitbox0.GetBottom() <= previousHitbox1.GetTop();
+}
+
+//------------------------------------------------------------------------------
+bool GameObject::IsUpCollision(const FloatRect& hitbox0, const FloatRect& previousHitbox0, const FloatRect& hitbox1, const FloatRect& previousHitbox1)
+{
+    return hitbox0.GetTop() <= hitbox1.GetBottom() && previousHitbox0.GetTop() >= previousHitbox1.GetBottom();
+}
 
+//------------------------------------------------------------------------------
+bool GameObject::IsLeftCollision(const FloatRect& hitbox0, const FloatRect& previousHitbox0, const FloatRect& hitbox1, const FloatRect& previousHitbox1)
+{
+    return hitbox0.GetLeft() <= hitbox1.GetRight() && previousHitbox0.GetLeft() >= previousHitbox1.GetRight();
+}
+
+//------------------------------------------------------------------------------
+bool GameObject::IsRightCollision(const FloatRect& hitbox0, const FloatRect& previousHitbox0, const FloatRect& hitbox1, const FloatRect& previousHitbox1)
+{
     return hitbox0.GetRight() >= hitbox1.GetLeft() && previousHitbox0.GetRight() <= previousHitbox1.GetLeft();
 }
\ No newline at end of file
@@ -13,6 +13,13 @@
 #include "FloatRect.h"
 #include "EventQueue.h"
 
+//------------------------------------------------------------------------------
+enum class ActivationPolicy : uint32_t
+{
+    SLEEP_OUTSIDE_REGION = 0,
+    ALWAYS_ACTIVE
+};
+
 //------------------------------------------------------------------------------
 class GameObject : public sf::Drawable, public Tranformable
 {
@@ -20,12 +27,23 @@ public:
     virtual ~GameObject() = default;
 
     virtual FloatRect GetGlobalBounds() const = 0;
+    const FloatRect& GetCachedGlobalBounds() const
+    {
+        if (mIsBoundsDirty)
+        {
+            mCachedGlobalBounds = GetGlobalBounds();
+            mIsBoundsDirty = false;
+        }
+        return mCachedGlobalBounds;
+    }
     virtual uint32_t GetDepth() const { return 0; }
     virtual void Update(const sf::Time& timeslice) { };
+    virtual bool IsUpdatable() const { return true; }   // Must not change while in a group
+    virtual ActivationPolicy GetActivationPolicy() const { return ActivationPolicy::SLEEP_OUTSIDE_REGION; }
     virtual void draw(sf::RenderTarget& target, const sf::RenderStates& states) const { }
 
     // Collision detection
-    virtual FloatRect GetHitbox() const { return GetGlobalBounds(); }
+    virtual FloatRect GetHitbox() const { return GetCachedGlobalBounds(); }
     virtual FloatRect GetPreviousHitbox() const { return GetHitbox(); }
     virtual const sf::Vector2f GetVelocity() const { return { }; };
     bool IsDownCollision(const GameObject& other) const;
@@ -33,11 +51,18 @@ public:
     bool IsLeftCollision(const GameObject& other) const;
     bool IsRightCollision(const GameObject& other) const;
 
+    // Rect tests for callers that already hold both hitboxes, no virtual lookups
+    static bool IsDownCollision(const FloatRect& hitbox0, const FloatRect& previousHitbox0, const FloatRect& hitbox1, const FloatRect& previousHitbox1);
+    static bool IsUpCollision(const FloatRect& hitbox0, const FloatRect& previousHitbox0, const FloatRect& hitbox1, const FloatRect& previousHitbox1);
+    static bool IsLeftCollision(const FloatRect& hitbox0, const FloatRect& previousHitbox0, const FloatRect& hitbox1, const FloatRect& previousHitbox1);
+    static bool IsRightCollision(const FloatRect& hitbox0, const FloatRect& previousHitbox0, const FloatRect& hitbox1, const FloatRect& previousHitbox1);
+
     // Group Membership
     void Kill();
     void TrackGroupMembership(Group* group);
     void UntrackGroupMembership(Group* group);
     bool IsMarkedForRemoval() const { return mIsMarkedForRemoval; }
+    void NotifyHitboxChanged();
 
     // Event Handling
     void SetEntityId(uint32_t entityId) { mEntityId = entityId; }
@@ -45,7 +70,8 @@ public:
     virtual void HandleEvent(Event* event) { };
 
 private:
-    std::unordered_set<Group*> mTrackedGroups;
+    mutable FloatRect mCachedGlobalBounds;
+    uint64_t mGroupMask = 0;                    // Bit per group id, see Group::MAX_GROUPS
     bool mIsMarkedForRemoval = false;
     uint32_t mEntityId = 0;
 };
\ No newline at end of file
@@ -21,18 +21,19 @@ GameObjectManager::GameObjectManager()
 //------------------------------------------------------------------------------
 void GameObjectManager::SyncGameObjectChanges()
 {
-    for (auto it = mGameObjects.begin(); it != mGameObjects.end(); )
+    for (size_t i = 0; i < mGameObjects.Count(); )
     {
-        if ((*it)->IsMarkedForRemoval())
+        GameObject* gameObject = mGameObjects[i].get();
+        if (gameObject->IsMarkedForRemoval())
         {
-            EventQueue::Instance()->QueueEvent(std::make_unique<EntityRemovedFromSceneEvent>((*it)->GetEntityId()));
-            mGameObjectLookup.erase((*it)->GetEntityId());
-            it = mGameObjects.erase(it);
+            EventQueue::Instance()->QueueEvent(std::make_unique<EntityRemovedFromSceneEvent>(gameObject->GetEntityId()));
+            // Swap-remove, the last object moves into this index and is visited next
+            mGameObjects.RemoveAt(i);
         }
         else
         {
-            EventQueue::Instance()->DispatchEvents(it->get());
-            ++it;
+            EventQueue::Instance()->DispatchEvents(gameObject);
+            ++i;
         }
     }
     EventQueue::Instance()->Clear();
@@ -41,23 +42,33 @@ void GameObjectManager::SyncGameObjectChanges()
 //------------------------------------------------------------------------------
 GameObject* GameObjectManager::GetInstance(uint32_t entityId)
 {
-    auto it = mGameObjectLookup.find(entityId);
-    if (it != mGameObjectLookup.end())
+    GameObjectPtr* gameObject = mGameObjects.Get(entityId);
+    return gameObject ? gameObject->get() : nullptr;
+}
+
+//------------------------------------------------------------------------------
+void GameObjectManager::DestroyGameObjectsBefore(size_t mark)
+{
+    // Swap-remove pulls the newer objects forward, so walking down only ever visits older ones
+    for (size_t i = mark; i > 0; i--)
     {
-        return it->second;
+        DestroyGameObject(i - 1);
     }
-    return nullptr;
 }
 
 //------------------------------------------------------------------------------
-void GameObjectManager::RemoveAllGameObjects()
+void GameObjectManager::DestroyGameObjectsFrom(size_t mark)
 {
-    for (const std::unique_ptr<GameObject>& object : mGameObjects)
+    while (mGameObjects.Count() > mark)
     {
-        if (!object->IsMarkedForRemoval())
-        {
-            object->Kill();
-        }
+        DestroyGameObject(mGameObjects.Count() - 1);
     }
-    SyncGameObjectChanges();
+}
+
+//------------------------------------------------------------------------------
+void GameObjectManager::DestroyGameObject(size_t index)
+{
+    // Removal events are dispatched to the survivors on the next sync, the slot goes back to its pool
+    EventQueue::Instance()->QueueEvent(std::make_unique<EntityRemovedFromSceneEvent>(mGameObjects[index]->GetEntityId()));
+    mGameObjects.RemoveAt(index);
 }
\ No newline at end of file
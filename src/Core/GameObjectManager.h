@@ -5,6 +5,8 @@
 // Core
 #include "GameObject.h"
 #include "EventQueue.h"
+#include "SlotMap.h"
+#include "ObjectPool.h"
 
 //------------------------------------------------------------------------------
 class GameObjectManager
@@ -20,26 +22,48 @@ public:
     template<typename T, typename... Args>
     T* CreateGameObject(Args&&... args)
     {
-        auto gameObject = std::make_unique<T>(std::forward<Args>(args)...);
-        gameObject->SetEntityId(++mEntityIdCounter);
+        ObjectPool<T, GameObject>& pool = GetPool<T>();
+        T* ptr = pool.Create(std::forward<Args>(args)...);
+        GameObjectPtr gameObject(ptr, PoolDeleter<GameObject>{ &pool });
 
-        T* ptr = gameObject.get();
-        mGameObjectLookup[mEntityIdCounter] = ptr;
-        mGameObjects.insert(std::move(gameObject));
+        // The entity id is the generational handle, stale ids never resolve to a reused slot
+        ptr->SetEntityId(mGameObjects.Insert(std::move(gameObject)));
 
         return ptr;
     }
 
     void SyncGameObjectChanges();
     GameObject* GetInstance(uint32_t entityId);
-    void RemoveAllGameObjects();
 
-    size_t Count() const { return mGameObjects.size(); }
+    // Objects are appended in creation order until the next sync, so a Count() taken before a level is
+    // built separates its objects from the older ones. Bulk teardown skips group bookkeeping, every group
+    // holding the destroyed objects must already be gone
+    void DestroyGameObjectsBefore(size_t mark);
+    void DestroyGameObjectsFrom(size_t mark);
+
+    size_t Count() const { return mGameObjects.Count(); }
 
 private:
+    using GameObjectPtr = std::unique_ptr<GameObject, PoolDeleter<GameObject>>;
+
     GameObjectManager();
+    void DestroyGameObject(size_t index);
+
+    template<typename T>
+    ObjectPool<T, GameObject>& GetPool()
+    {
+        // The manager is a singleton, so each type gets exactly one pool created on first use
+        static ObjectPool<T, GameObject>* sPool = nullptr;
+        if (sPool == nullptr)
+        {
+            auto pool = std::make_unique<ObjectPool<T, GameObject>>();
+            sPool = pool.get();
+            mPools.push_back(std::move(pool));
+        }
+        return *sPool;
+    }
 
-    std::unordered_map<uint32_t, GameObject*> mGameObjectLookup;
-    std::unordered_set<std::unique_ptr<GameObject>> mGameObjects;
-    uint32_t mEntityIdCounter = 0;
+    // Declared before the objects so the pools outlive them on destruction
+    std::vector<std::unique_ptr<IObjectPool<GameObject>>> mPools;
+    SlotMap<GameObjectPtr> mGameObjects;
 };
\ No newline at end of file
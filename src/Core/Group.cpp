@@ -4,9 +4,18 @@
 #include "Group.h"
 #include "GameObjectManager.h"
 
+// System
+#include <stdexcept>
+#include <string>
+
+// Static definitions
+//------------------------------------------------------------------------------
+Group* Group::sGroupsById[Group::MAX_GROUPS] = { };
+uint64_t Group::sUsedGroupIds = 0;
+
 //------------------------------------------------------------------------------
-GroupIterator::GroupIterator(std::vector<GameObject*>::iterator it, Group* group)
-    : mCurrent(it)
+GroupIterator::GroupIterator(size_t index, Group* group)
+    : mIndex(index)
     , mGroup(group)
 {
     ++mGroup->mIterationCounter;
@@ -25,7 +34,7 @@ GroupIterator::~GroupIterator()
 //------------------------------------------------------------------------------
 GroupIterator& GroupIterator::operator++()
 {
-    ++mCurrent;
+    ++mIndex;
     SkipMarked();
     return *this;
 }
@@ -33,53 +42,409 @@ GroupIterator& GroupIterator::operator++()
 //------------------------------------------------------------------------------
 GameObject* GroupIterator::operator*()
 {
-    return *mCurrent;
+    return mGroup->mSortedGameObjects[mIndex];
 }
 
 //------------------------------------------------------------------------------
 bool GroupIterator::operator!=(const GroupIterator& other)
 {
-    return mCurrent != other.mCurrent;
+    return mIndex != other.mIndex;
 }
 
 //------------------------------------------------------------------------------
 void GroupIterator::SkipMarked()
 {
-    while (mCurrent != mGroup->mSortedGameObjects.end() && mGroup->mRemoveQueue.find(*mCurrent) != mGroup->mRemoveQueue.end())
+    while (mIndex < mGroup->mSortedGameObjects.size() && mGroup->IsTombstoned(static_cast<uint32_t>(mIndex)))
+    {
+        ++mIndex;
+    }
+}
+
+//------------------------------------------------------------------------------
+Group::Group()
+{
+    if (sUsedGroupIds == UINT64_MAX)
     {
-        ++mCurrent;
+        throw std::runtime_error("Out of group ids, at most " + std::to_string(MAX_GROUPS) + " groups can exist at once");
     }
+
+    mId = GetLowestBitIndex(~sUsedGroupIds);
+    sUsedGroupIds |= uint64_t(1) << mId;
+    sGroupsById[mId] = this;
+}
+
+//------------------------------------------------------------------------------
+Group::~Group()
+{
+    // The id is handed out again, so members must not keep pointing at it
+    for (GameObject* obj : mSortedGameObjects)
+    {
+        obj->UntrackGroupMembership(this);
+    }
+    for (GameObject* obj : mAddQueue)
+    {
+        obj->UntrackGroupMembership(this);
+    }
+
+    sUsedGroupIds &= ~(uint64_t(1) << mId);
+    sGroupsById[mId] = nullptr;
 }
 
 //------------------------------------------------------------------------------
 void Group::AddGameObject(GameObject* obj)
 {
-    if (!obj->IsMarkedForRemoval() && mAddQueue.find(obj) == mAddQueue.end())
+    if (obj->IsMarkedForRemoval())
     {
-        obj->TrackGroupMembership(this);
+        return;
+    }
 
-        mAddQueue.insert(obj);
-        mRemoveQueue.erase(obj);
-        ProcessQueues();
+    Entry& entry = GetEntry(obj);
+    if (entry.mDenseIndex != INVALID_INDEX)
+    {
+        // Adding back a member removed earlier in the same iteration just revives it
+        if (IsTombstoned(entry.mDenseIndex))
+        {
+            obj->TrackGroupMembership(this);
+            SetTombstone(entry.mDenseIndex, false);
+        }
+        return;
+    }
+
+    if (entry.mAddQueueIndex == INVALID_INDEX)
+    {
+        obj->TrackGroupMembership(this);
+        if (mIterationCounter > 0)
+        {
+            entry.mAddQueueIndex = static_cast<uint32_t>(mAddQueue.size());
+            mAddQueue.push_back(obj);
+        }
+        else
+        {
+            Insert(obj);
+        }
     }
 }
 
 //------------------------------------------------------------------------------
 void Group::RemoveGameObject(GameObject* obj)
 {
-    if (mRemoveQueue.find(obj) == mRemoveQueue.end())
+    if (FindEntry(obj) == nullptr)
     {
+        return;
+    }
 
+    Entry& entry = GetEntry(obj);
+    if (entry.mAddQueueIndex != INVALID_INDEX)
+    {
+        obj->UntrackGroupMembership(this);
+
+        GameObject* lastObj = mAddQueue.back();
+        mAddQueue[entry.mAddQueueIndex] = lastObj;
+        GetEntry(lastObj).mAddQueueIndex = entry.mAddQueueIndex;
+        mAddQueue.pop_back();
+        entry.mAddQueueIndex = INVALID_INDEX;
+    }
+    else if (!IsTombstoned(entry.mDenseIndex))
+    {
         obj->UntrackGroupMembership(this);
 
-        mRemoveQueue.insert(obj);
-        mAddQueue.erase(obj);
+        // Removal is deferred while iterating, the tombstone hides the member until then
+        if (mIterationCounter > 0)
+        {
+            SetTombstone(entry.mDenseIndex, true);
+            mPendingRemovals.push_back(entry.mDenseIndex);
+        }
+        else
+        {
+            Erase(entry.mDenseIndex);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void Group::Update(const sf::Time& timeslice, const std::optional<FloatRect>& activeRegion)
+{
+    // Same deferral as GroupIterator, objects added or removed by an update are applied afterwards
+    ++mIterationCounter;
+    for (size_t index = 0; index < mUpdatableGameObjects.size(); index++)
+    {
+        GameObject* obj = mUpdatableGameObjects[index];
+        if (IsTombstoned(GetEntry(obj).mDenseIndex))
+        {
+            continue;
+        }
+
+        // Sleeping objects keep their state and resume from it on re-entering the region
+        if (activeRegion && obj->GetActivationPolicy() == ActivationPolicy::SLEEP_OUTSIDE_REGION &&
+            !activeRegion->FindIntersection(obj->GetCachedGlobalBounds()))
+        {
+            continue;
+        }
+
+        obj->Update(timeslice);
+    }
+
+    if (--mIterationCounter == 0)
+    {
         ProcessQueues();
     }
 }
 
 //------------------------------------------------------------------------------
-void Group::Sort(const std::function<bool(GameObject*, GameObject*)>& compareFunc)
+void Group::EnableSpatialHash(float cellSize)
+{
+    mSpatialHash = std::make_unique<SpatialHash>(cellSize);
+    for (GameObject* obj : mSortedGameObjects)
+    {
+        mSpatialHash->Insert(obj, obj->GetHitbox(), obj->GetPreviousHitbox());
+    }
+}
+
+//------------------------------------------------------------------------------
+void Group::EnableAabbTree(float fatMargin)
+{
+    mAabbTree = std::make_unique<DynamicAabbTree>(fatMargin);
+    for (GameObject* obj : mSortedGameObjects)
+    {
+        mAabbTree->Insert(obj, obj->GetHitbox());
+    }
+}
+
+//------------------------------------------------------------------------------
+void Group::UpdateBroadphase(GameObject* obj)
+{
+    if (mSpatialHash)
+    {
+        mSpatialHash->Update(obj, obj->GetHitbox(), obj->GetPreviousHitbox());
+    }
+    if (mAabbTree)
+    {
+        mAabbTree->Update(obj, obj->GetHitbox());
+    }
+}
+
+//------------------------------------------------------------------------------
+std::vector<std::pair<GameObject*, GameObject*>> Group::QueryOverlapPairs() const
+{
+    auto isActive = [this](GameObject* obj) { return !IsPendingRemoval(obj); };
+
+    std::vector<std::pair<GameObject*, GameObject*>> pairs;
+    auto addPair = [&](GameObject* obj0, GameObject* obj1)
+    {
+        if (isActive(obj0) && isActive(obj1) && obj0->GetHitbox().FindIntersection(obj1->GetHitbox()))
+        {
+            pairs.emplace_back(obj0, obj1);
+        }
+    };
+
+    if (mAabbTree)
+    {
+        mAabbTree->QueryOverlapPairs(addPair);
+    }
+    else
+    {
+        for (size_t i = 0; i < mSortedGameObjects.size(); i++)
+        {
+            for (size_t j = i + 1; j < mSortedGameObjects.size(); j++)
+            {
+                addPair(mSortedGameObjects[i], mSortedGameObjects[j]);
+            }
+        }
+    }
+
+    return pairs;
+}
+
+//------------------------------------------------------------------------------
+std::optional<RayHit> Group::RayCast(const sf::Vector2f& from, const sf::Vector2f& to) const
 {
-    std::sort(mSortedGameObjects.begin(), mSortedGameObjects.end(), compareFunc);
+    std::optional<RayHit> closestHit;
+    auto testObject = [&](GameObject* obj, float)
+    {
+        // Fat bounds only narrow the search, the hit is taken against the real hitbox
+        float fraction = 0.0f;
+        float maxFraction = closestHit ? closestHit->mFraction : 1.0f;
+        if (!IsPendingRemoval(obj) &&
+            DynamicAabbTree::IntersectSegment(obj->GetHitbox(), from, to, maxFraction, fraction))
+        {
+            closestHit = RayHit{ obj, fraction };
+            return fraction;
+        }
+        return 1.0f;
+    };
+
+    if (mAabbTree)
+    {
+        mAabbTree->RayCast(from, to, testObject);
+    }
+    else
+    {
+        for (GameObject* obj : mSortedGameObjects)
+        {
+            testObject(obj, 0.0f);
+        }
+    }
+
+    return closestHit;
+}
+
+//------------------------------------------------------------------------------
+const std::vector<Group::QueryHit>& Group::CollectQueryHits(const FloatRect& area) const
+{
+    // The tree only narrows the candidates to fat bounds, the hit is taken against the real hitbox
+    const std::vector<GameObject*>* candidates = &mSortedGameObjects;
+    if (mAabbTree)
+    {
+        mQueryCandidates.clear();
+        mAabbTree->QueryAABB(area, mQueryCandidates);
+        candidates = &mQueryCandidates;
+    }
+
+    mQueryHits.clear();
+    for (GameObject* obj : *candidates)
+    {
+        FloatRect hitbox = obj->GetHitbox();
+        if (hitbox.FindIntersection(area))
+        {
+            mQueryHits.push_back({ obj, hitbox, obj->GetPreviousHitbox() });
+        }
+    }
+    return mQueryHits;
+}
+
+//------------------------------------------------------------------------------
+Group::Entry& Group::GetEntry(GameObject* obj)
+{
+    // Entity ids are slot map handles, so the slot index is a dense key unique among live objects
+    assert(obj->GetEntityId() != 0);
+    uint32_t slotIndex = GetSlotIndex(obj->GetEntityId());
+    if (slotIndex >= mEntries.size())
+    {
+        mEntries.resize(slotIndex + 1);
+    }
+    return mEntries[slotIndex];
+}
+
+//------------------------------------------------------------------------------
+const Group::Entry* Group::FindEntry(GameObject* obj) const
+{
+    uint32_t slotIndex = GetSlotIndex(obj->GetEntityId());
+    if (slotIndex >= mEntries.size())
+    {
+        return nullptr;
+    }
+
+    const Entry& entry = mEntries[slotIndex];
+    if ((entry.mDenseIndex != INVALID_INDEX && mSortedGameObjects[entry.mDenseIndex] == obj) ||
+        (entry.mAddQueueIndex != INVALID_INDEX && mAddQueue[entry.mAddQueueIndex] == obj))
+    {
+        return &entry;
+    }
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+void Group::Insert(GameObject* obj)
+{
+    Entry& entry = GetEntry(obj);
+    entry.mDenseIndex = static_cast<uint32_t>(mSortedGameObjects.size());
+    mSortedGameObjects.push_back(obj);
+    if (mTombstones.size() * 64 < mSortedGameObjects.size())
+    {
+        mTombstones.push_back(0);
+    }
+
+    if (obj->IsUpdatable())
+    {
+        entry.mUpdatableIndex = static_cast<uint32_t>(mUpdatableGameObjects.size());
+        mUpdatableGameObjects.push_back(obj);
+    }
+    if (mSpatialHash)
+    {
+        mSpatialHash->Insert(obj, obj->GetHitbox(), obj->GetPreviousHitbox());
+    }
+    if (mAabbTree)
+    {
+        mAabbTree->Insert(obj, obj->GetHitbox());
+    }
+}
+
+//------------------------------------------------------------------------------
+void Group::Erase(uint32_t denseIndex)
+{
+    GameObject* obj = mSortedGameObjects[denseIndex];
+    Entry& entry = GetEntry(obj);
+
+    GameObject* lastObj = mSortedGameObjects.back();
+    mSortedGameObjects[denseIndex] = lastObj;
+    GetEntry(lastObj).mDenseIndex = denseIndex;
+    mSortedGameObjects.pop_back();
+
+    if (entry.mUpdatableIndex != INVALID_INDEX)
+    {
+        GameObject* lastUpdatableObj = mUpdatableGameObjects.back();
+        mUpdatableGameObjects[entry.mUpdatableIndex] = lastUpdatableObj;
+        GetEntry(lastUpdatableObj).mUpdatableIndex = entry.mUpdatableIndex;
+        mUpdatableGameObjects.pop_back();
+    }
+
+    // Only valid while the object is alive, the slot is reused once the manager frees it
+    entry.mDenseIndex = INVALID_INDEX;
+    entry.mUpdatableIndex = INVALID_INDEX;
+
+    if (mSpatialHash)
+    {
+        mSpatialHash->Remove(obj);
+    }
+    if (mAabbTree)
+    {
+        mAabbTree->Remove(obj);
+    }
+}
+
+//------------------------------------------------------------------------------
+void Group::SetTombstone(uint32_t denseIndex, bool isSet)
+{
+    uint64_t bit = uint64_t(1) << (denseIndex & 63);
+    if (isSet)
+    {
+        mTombstones[denseIndex >> 6] |= bit;
+    }
+    else
+    {
+        mTombstones[denseIndex >> 6] &= ~bit;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool Group::IsPendingRemoval(GameObject* obj) const
+{
+    const Entry* entry = FindEntry(obj);
+    return entry && entry->mDenseIndex != INVALID_INDEX && IsTombstoned(entry->mDenseIndex);
+}
+
+//------------------------------------------------------------------------------
+void Group::ProcessQueues()
+{
+    if (mIterationCounter == 0)
+    {
+        // Highest index first so a swap-remove never moves another tombstoned member
+        std::sort(mPendingRemovals.begin(), mPendingRemovals.end(), std::greater<uint32_t>());
+        for (uint32_t denseIndex : mPendingRemovals)
+        {
+            if (IsTombstoned(denseIndex))
+            {
+                SetTombstone(denseIndex, false);
+                Erase(denseIndex);
+            }
+        }
+        mPendingRemovals.clear();
+
+        for (GameObject* obj : mAddQueue)
+        {
+            GetEntry(obj).mAddQueueIndex = INVALID_INDEX;
+            Insert(obj);
+        }
+        mAddQueue.clear();
+    }
 }
\ No newline at end of file
@@ -2,12 +2,17 @@
 
 // Includes
 //------------------------------------------------------------------------------
+// Core
+#include "SpatialHash.h"
+#include "DynamicAabbTree.h"
+
 // System
-#include <unordered_set>
 #include <vector>
-#include <functional>
 #include <algorithm>
+#include <cassert>
 #include <cstdint>
+#include <memory>
+#include <optional>
 
 // Forward declarations
 //------------------------------------------------------------------------------
@@ -18,7 +23,7 @@ class Group;
 class GroupIterator
 {
 public:
-    explicit GroupIterator(std::vector<GameObject*>::iterator it, Group* group);
+    explicit GroupIterator(size_t index, Group* group);
     ~GroupIterator();
 
     GroupIterator& operator++();
@@ -28,7 +33,7 @@ public:
 private:
     void SkipMarked();
 
-    std::vector<GameObject*>::iterator mCurrent;
+    size_t mIndex;
     Group* mGroup;
 };
 
@@ -38,45 +43,108 @@ class Group
     friend GroupIterator;
 
 public:
+    // Ids index the membership bitmask every object carries, so only this many groups can exist at once
+    static constexpr uint32_t MAX_GROUPS = 64;
+
+    Group();
+    ~Group();
+    Group(const Group&) = delete;
+    Group& operator=(const Group&) = delete;
+
+    static Group* GetGroupById(uint32_t groupId) { return sGroupsById[groupId]; }
+    uint32_t GetId() const { return mId; }
+
     void AddGameObject(GameObject* obj);
     void RemoveGameObject(GameObject* obj);
-    void Sort(const std::function<bool(GameObject*, GameObject*)>& compareFunc);
+
+    // Ticks only members that declare themselves updatable, members outside the active region sleep
+    void Update(const sf::Time& timeslice, const std::optional<FloatRect>& activeRegion = std::nullopt);
+
+    // Broadphase for collision groups, static members suit the hash and moving members the tree
+    void EnableSpatialHash(float cellSize);
+    void EnableAabbTree(float fatMargin);
+    void UpdateBroadphase(GameObject* obj);
+    std::vector<std::pair<GameObject*, GameObject*>> QueryOverlapPairs() const;
+    std::optional<RayHit> RayCast(const sf::Vector2f& from, const sf::Vector2f& to) const;
+
+    // Calls callback(GameObject*, const FloatRect& hitbox, const FloatRect& previousHitbox) for every member
+    // overlapping the area, hashed groups hand out the rects stored in their cells
+    template<typename Callback>
+    void QueryAABB(const FloatRect& area, Callback callback) const
+    {
+        auto reportActive = [&](GameObject* obj, const FloatRect& hitbox, const FloatRect& previousHitbox)
+        {
+            // Members queued for removal are skipped like during iteration
+            if (mPendingRemovals.empty() || !IsPendingRemoval(obj))
+            {
+                callback(obj, hitbox, previousHitbox);
+            }
+        };
+
+        if (mSpatialHash)
+        {
+            mSpatialHash->QueryAABB(area, reportActive);
+            return;
+        }
+
+        for (const QueryHit& hit : CollectQueryHits(area))
+        {
+            reportActive(hit.mObject, hit.mHitbox, hit.mPreviousHitbox);
+        }
+    }
 
     GroupIterator begin()
     {
-        return GroupIterator(mSortedGameObjects.begin(), this);
+        return GroupIterator(0, this);
     }
 
     GroupIterator end()
     {
-        return GroupIterator(mSortedGameObjects.end(), this);
+        return GroupIterator(mSortedGameObjects.size(), this);
     }
 
 private:
-    void ProcessQueues()
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    // Sparse entry per entity slot, indices into the dense member lists and the add queue
+    struct Entry
     {
-        if (mIterationCounter == 0)
-        {
-            for (GameObject* obj : mAddQueue)
-            {
-                mSortedGameObjects.push_back(obj);
-            }
-            mAddQueue.clear();
+        uint32_t mDenseIndex = INVALID_INDEX;
+        uint32_t mUpdatableIndex = INVALID_INDEX;
+        uint32_t mAddQueueIndex = INVALID_INDEX;
+    };
 
-            for (GameObject* obj : mRemoveQueue)
-            {
-                auto it = std::find(mSortedGameObjects.begin(), mSortedGameObjects.end(), obj);
-                if (it != mSortedGameObjects.end())
-                {
-                    mSortedGameObjects.erase(it);
-                }
-            }
-            mRemoveQueue.clear();
-        }
-    }
+    struct QueryHit
+    {
+        GameObject* mObject;
+        FloatRect mHitbox;
+        FloatRect mPreviousHitbox;
+    };
+
+    // Fills the scratch hit list for groups without a hash, so queries must not nest
+    const std::vector<QueryHit>& CollectQueryHits(const FloatRect& area) const;
+    Entry& GetEntry(GameObject* obj);
+    const Entry* FindEntry(GameObject* obj) const;
+    void Insert(GameObject* obj);
+    void Erase(uint32_t denseIndex);
+    bool IsTombstoned(uint32_t denseIndex) const { return (mTombstones[denseIndex >> 6] >> (denseIndex & 63)) & 1; }
+    void SetTombstone(uint32_t denseIndex, bool isSet);
+    bool IsPendingRemoval(GameObject* obj) const;
+    void ProcessQueues();
+
+    static Group* sGroupsById[MAX_GROUPS];
+    static uint64_t sUsedGroupIds;
 
+    uint32_t mId;
     std::vector<GameObject*> mSortedGameObjects;
-    std::unordered_set<GameObject*> mRemoveQueue;
-    std::unordered_set<GameObject*> mAddQueue;
+    std::vector<GameObject*> mUpdatableGameObjects;
+    std::vector<Entry> mEntries;
+    std::vector<uint64_t> mTombstones;          // Members removed while the group is being iterated
+    std::vector<uint32_t> mPendingRemovals;
+    std::vector<GameObject*> mAddQueue;
+    std::unique_ptr<SpatialHash> mSpatialHash;
+    std::unique_ptr<DynamicAabbTree> mAabbTree;
+    mutable std::vector<GameObject*> mQueryCandidates;
+    mutable std::vector<QueryHit> mQueryHits;
     uint32_t mIterationCounter{ 0 };
 };
\ No newline at end of file
@@ -0,0 +1,125 @@
+// Includes
+//------------------------------------------------------------------------------
+// Core
+#include "HitboxStore.h"
+
+// System
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define HITBOX_STORE_USE_SSE
+#endif
+
+//------------------------------------------------------------------------------
+size_t HitboxStore::Add(GameObject* obj, const FloatRect& hitbox, const FloatRect& previousHitbox)
+{
+    mLefts.push_back(hitbox.GetLeft());
+    mTops.push_back(hitbox.GetTop());
+    mRights.push_back(hitbox.GetRight());
+    mBottoms.push_back(hitbox.GetBottom());
+    mPreviousHitboxes.push_back(previousHitbox);
+    mObjects.push_back(obj);
+    mIndices[obj] = mObjects.size() - 1;
+    return mObjects.size() - 1;
+}
+
+//------------------------------------------------------------------------------
+void HitboxStore::Set(size_t index, const FloatRect& hitbox, const FloatRect& previousHitbox)
+{
+    mLefts[index] = hitbox.GetLeft();
+    mTops[index] = hitbox.GetTop();
+    mRights[index] = hitbox.GetRight();
+    mBottoms[index] = hitbox.GetBottom();
+    mPreviousHitboxes[index] = previousHitbox;
+}
+
+//------------------------------------------------------------------------------
+void HitboxStore::RemoveAt(size_t index)
+{
+    // Swap with the last entry to keep the arrays dense
+    mIndices.erase(mObjects[index]);
+    if (index + 1 != mObjects.size())
+    {
+        mIndices[mObjects.back()] = index;
+    }
+
+    mLefts[index] = mLefts.back();
+    mTops[index] = mTops.back();
+    mRights[index] = mRights.back();
+    mBottoms[index] = mBottoms.back();
+    mPreviousHitboxes[index] = mPreviousHitboxes.back();
+    mObjects[index] = mObjects.back();
+
+    mLefts.pop_back();
+    mTops.pop_back();
+    mRights.pop_back();
+    mBottoms.pop_back();
+    mPreviousHitboxes.pop_back();
+    mObjects.pop_back();
+}
+
+//------------------------------------------------------------------------------
+size_t HitboxStore::Find(const GameObject* obj) const
+{
+    auto itr = mIndices.find(obj);
+    return itr != mIndices.end() ? itr->second : NOT_FOUND;
+}
+
+//------------------------------------------------------------------------------
+void HitboxStore::Clear()
+{
+    mLefts.clear();
+    mTops.clear();
+    mRights.clear();
+    mBottoms.clear();
+    mPreviousHitboxes.clear();
+    mObjects.clear();
+    mIndices.clear();
+}
+
+//------------------------------------------------------------------------------
+size_t HitboxStore::TestOverlaps(const FloatRect& area, std::vector<uint64_t>& hits) const
+{
+    // Strict comparisons so touching edges do not count, same as FloatRect::FindIntersection
+    const size_t count = mObjects.size();
+    const float areaLeft = area.GetLeft();
+    const float areaTop = area.GetTop();
+    const float areaRight = area.GetRight();
+    const float areaBottom = area.GetBottom();
+
+    hits.assign((count + 63) / 64, 0);
+    size_t hitCount = 0;
+    size_t i = 0;
+
+#if defined(HITBOX_STORE_USE_SSE)
+    const __m128 left = _mm_set1_ps(areaLeft);
+    const __m128 top = _mm_set1_ps(areaTop);
+    const __m128 right = _mm_set1_ps(areaRight);
+    const __m128 bottom = _mm_set1_ps(areaBottom);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 overlapX = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(&mLefts[i]), right), 
+                                     _mm_cmplt_ps(left, _mm_loadu_ps(&mRights[i])));
+        __m128 overlapY = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(&mTops[i]), bottom), 
+                                     _mm_cmplt_ps(top, _mm_loadu_ps(&mBottoms[i])));
+        uint64_t laneMask = static_cast<uint64_t>(_mm_movemask_ps(_mm_and_ps(overlapX, overlapY)));
+        if (laneMask != 0)
+        {
+            // Groups of four never straddle a 64-bit word
+            hits[i >> 6] |= laneMask << (i & 63);
+            hitCount += ((laneMask & 1) != 0) + ((laneMask & 2) != 0) + ((laneMask & 4) != 0) + ((laneMask & 8) != 0);
+        }
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        if (mLefts[i] < areaRight && areaLeft < mRights[i] && mTops[i] < areaBottom && areaTop < mBottoms[i])
+        {
+            hits[i >> 6] |= uint64_t(1) << (i & 63);
+            hitCount++;
+        }
+    }
+
+    return hitCount;
+}
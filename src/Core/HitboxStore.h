@@ -0,0 +1,83 @@
+#pragma once
+
+// Includes
+//------------------------------------------------------------------------------
+// Core
+#include "FloatRect.h"
+
+// System
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Forward declarations
+//------------------------------------------------------------------------------
+class GameObject;
+
+//------------------------------------------------------------------------------
+inline uint32_t GetLowestBitIndex(uint64_t bits)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward64(&index, bits);
+    return static_cast<uint32_t>(index);
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(bits));
+#endif
+}
+
+//------------------------------------------------------------------------------
+class HitboxStore
+{
+public:
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    // The previous hitbox is kept beside the current one so collision response needs no virtual calls
+    size_t Add(GameObject* obj, const FloatRect& hitbox, const FloatRect& previousHitbox);
+    void Set(size_t index, const FloatRect& hitbox, const FloatRect& previousHitbox);
+    void RemoveAt(size_t index);
+    size_t Find(const GameObject* obj) const;
+    void Clear();
+
+    // Sets bit i of hits for every stored hitbox i overlapping the area, returns the hit count
+    size_t TestOverlaps(const FloatRect& area, std::vector<uint64_t>& hits) const;
+
+    // Calls callback(size_t index) for every overlapping hitbox, hits is scratch space
+    template<typename Callback>
+    void ForEachOverlap(const FloatRect& area, std::vector<uint64_t>& hits, Callback callback) const
+    {
+        if (TestOverlaps(area, hits) == 0)
+        {
+            return;
+        }
+
+        for (size_t word = 0; word < hits.size(); word++)
+        {
+            for (uint64_t bits = hits[word]; bits != 0; bits &= bits - 1)
+            {
+                callback(word * 64 + GetLowestBitIndex(bits));
+            }
+        }
+    }
+
+    size_t Count() const { return mObjects.size(); }
+    bool IsEmpty() const { return mObjects.empty(); }
+    GameObject* GetObject(size_t index) const { return mObjects[index]; }
+    FloatRect GetHitbox(size_t index) const
+    {
+        return FloatRect({ mLefts[index], mTops[index] }, { mRights[index] - mLefts[index], mBottoms[index] - mTops[index] });
+    }
+    const FloatRect& GetPreviousHitbox(size_t index) const { return mPreviousHitboxes[index]; }
+
+private:
+    std::vector<float> mLefts;
+    std::vector<float> mTops;
+    std::vector<float> mRights;
+    std::vector<float> mBottoms;
+    std::vector<FloatRect> mPreviousHitboxes;
+    std::vector<GameObject*> mObjects;
+    std::unordered_map<const GameObject*, size_t> mIndices;
+};
@@ -0,0 +1,120 @@
+#include "MappedFile.h"
+
+// Includes
+//------------------------------------------------------------------------------
+// System
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+//------------------------------------------------------------------------------
+MappedFile::MappedFile(const fs::path& filepath)
+{
+    mFileHandle = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, 
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (mFileHandle == INVALID_HANDLE_VALUE)
+    {
+        mFileHandle = nullptr;
+        throw std::runtime_error("Failed to open file: " + filepath.string());
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(mFileHandle, &fileSize))
+    {
+        CloseHandle(mFileHandle);
+        throw std::runtime_error("Failed to query file size: " + filepath.string());
+    }
+
+    mSize = static_cast<size_t>(fileSize.QuadPart);
+    if (mSize == 0)
+    {
+        return;  // Empty files cannot be mapped
+    }
+
+    mMappingHandle = CreateFileMappingW(mFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mMappingHandle == nullptr)
+    {
+        CloseHandle(mFileHandle);
+        throw std::runtime_error("Failed to map file: " + filepath.string());
+    }
+
+    mData = static_cast<const uint8_t*>(MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (mData == nullptr)
+    {
+        CloseHandle(mMappingHandle);
+        CloseHandle(mFileHandle);
+        throw std::runtime_error("Failed to map file: " + filepath.string());
+    }
+}
+
+//------------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+    if (mData != nullptr)
+    {
+        UnmapViewOfFile(mData);
+    }
+    if (mMappingHandle != nullptr)
+    {
+        CloseHandle(mMappingHandle);
+    }
+    if (mFileHandle != nullptr)
+    {
+        CloseHandle(mFileHandle);
+    }
+}
+#else
+//------------------------------------------------------------------------------
+MappedFile::MappedFile(const fs::path& filepath)
+{
+    mFileDescriptor = open(filepath.c_str(), O_RDONLY);
+    if (mFileDescriptor == -1)
+    {
+        throw std::runtime_error("Failed to open file: " + filepath.string());
+    }
+
+    struct stat fileStat;
+    if (fstat(mFileDescriptor, &fileStat) == -1)
+    {
+        close(mFileDescriptor);
+        throw std::runtime_error("Failed to query file size: " + filepath.string());
+    }
+
+    mSize = static_cast<size_t>(fileStat.st_size);
+    if (mSize == 0)
+    {
+        return;  // Empty files cannot be mapped
+    }
+
+    void* data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, mFileDescriptor, 0);
+    if (data == MAP_FAILED)
+    {
+        close(mFileDescriptor);
+        throw std::runtime_error("Failed to map file: " + filepath.string());
+    }
+    mData = static_cast<const uint8_t*>(data);
+}
+
+//------------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+    if (mData != nullptr)
+    {
+        munmap(const_cast<uint8_t*>(mData), mSize);
+    }
+    if (mFileDescriptor != -1)
+    {
+        close(mFileDescriptor);
+    }
+}
+#endif
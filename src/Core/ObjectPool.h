@@ -0,0 +1,94 @@
+#pragma once
+
+// Includes
+//------------------------------------------------------------------------------
+// System
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <utility>
+
+//------------------------------------------------------------------------------
+template<typename Base>
+class IObjectPool
+{
+public:
+    virtual ~IObjectPool() = default;
+    virtual void Release(Base* object) = 0;
+};
+
+//------------------------------------------------------------------------------
+// Returns an object to the pool it was allocated from instead of the heap
+template<typename Base>
+struct PoolDeleter
+{
+    IObjectPool<Base>* mPool = nullptr;
+
+    void operator()(Base* object) const { mPool->Release(object); }
+};
+
+//------------------------------------------------------------------------------
+// Slab allocator for a single concrete type, slots are handed out from fixed size
+// chunks and released slots are reused before a new chunk is allocated
+template<typename T, typename Base = T>
+class ObjectPool : public IObjectPool<Base>
+{
+public:
+    explicit ObjectPool(size_t chunkSize = 256)
+        : mChunkSize(chunkSize)
+    {
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template<typename... Args>
+    T* Create(Args&&... args)
+    {
+        if (mFreeSlots.empty())
+        {
+            AllocateChunk();
+        }
+
+        Slot* slot = mFreeSlots.back();
+        T* object = new (slot->mStorage) T(std::forward<Args>(args)...);
+        mFreeSlots.pop_back();
+        ++mLiveCount;
+        return object;
+    }
+
+    void Release(Base* object) override
+    {
+        T* typedObject = static_cast<T*>(object);
+        typedObject->~T();
+        mFreeSlots.push_back(reinterpret_cast<Slot*>(typedObject));
+        --mLiveCount;
+    }
+
+    size_t GetLiveCount() const { return mLiveCount; }
+    size_t GetCapacity() const { return mChunks.size() * mChunkSize; }
+
+private:
+    struct Slot
+    {
+        alignas(T) unsigned char mStorage[sizeof(T)];
+    };
+
+    void AllocateChunk()
+    {
+        mChunks.push_back(std::make_unique<Slot[]>(mChunkSize));
+        Slot* chunk = mChunks.back().get();
+
+        // Pushed in reverse so slots are handed out in address order
+        mFreeSlots.reserve(mFreeSlots.size() + mChunkSize);
+        for (size_t i = mChunkSize; i > 0; --i)
+        {
+            mFreeSlots.push_back(&chunk[i - 1]);
+        }
+    }
+
+    size_t mChunkSize;
+    size_t mLiveCount = 0;
+    std::vector<std::unique_ptr<Slot[]>> mChunks;
+    std::vector<Slot*> mFreeSlots;
+};
@@ -49,4 +49,10 @@ sf::Vector2f GetRectMidTop(const sf::FloatRect& rect)
 sf::Vector2f GetRectMidBottom(const sf::FloatRect& rect)
 {
     return sf::Vector2f(rect.left + rect.width / 2.0f, rect.top + rect.height);
+}
+
+//------------------------------------------------------------------------------
+sf::FloatRect GetViewBounds(const sf::View& view)
+{
+    return sf::FloatRect(view.getCenter() - view.getSize() / 2.0f, view.getSize());
 }
\ No newline at end of file
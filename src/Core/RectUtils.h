@@ -12,4 +12,5 @@ sf::Vector2f GetRectCenter(const sf::FloatRect& rect);
 sf::Vector2f GetRectMidRight(const sf::FloatRect& rect);
 sf::Vector2f GetRectMidLeft(const sf::FloatRect& rect);
 sf::Vector2f GetRectMidTop(const sf::FloatRect& rect);
-sf::Vector2f GetRectMidBottom(const sf::FloatRect& rect);
\ No newline at end of file
+sf::Vector2f GetRectMidBottom(const sf::FloatRect& rect);
+sf::FloatRect GetViewBounds(const sf::View& view);
\ No newline at end of file
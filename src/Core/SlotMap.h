@@ -0,0 +1,136 @@
+#pragma once
+
+// Includes
+//------------------------------------------------------------------------------
+// System
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+
+//------------------------------------------------------------------------------
+constexpr uint32_t SLOT_INDEX_BITS = 20;
+constexpr uint32_t SLOT_INDEX_MASK = (1u << SLOT_INDEX_BITS) - 1;
+
+//------------------------------------------------------------------------------
+inline uint32_t GetSlotIndex(uint32_t handle)
+{
+    return handle & SLOT_INDEX_MASK;
+}
+
+//------------------------------------------------------------------------------
+// Dense storage addressed by generational handles, a handle packs the slot index
+// in the low bits and the slot generation in the high bits. Handle 0 is never issued.
+template<typename T>
+class SlotMap
+{
+public:
+    static constexpr uint32_t INDEX_BITS = SLOT_INDEX_BITS;
+    static constexpr uint32_t INDEX_MASK = SLOT_INDEX_MASK;
+    static constexpr uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+    static constexpr uint32_t INVALID_HANDLE = 0;
+
+    uint32_t Insert(T value)
+    {
+        uint32_t slotIndex;
+        if (mFreeSlots.empty())
+        {
+            assert(mSlots.size() <= INDEX_MASK);
+            slotIndex = static_cast<uint32_t>(mSlots.size());
+            mSlots.push_back({ 0, 1 });
+        }
+        else
+        {
+            slotIndex = mFreeSlots.back();
+            mFreeSlots.pop_back();
+        }
+
+        Slot& slot = mSlots[slotIndex];
+        slot.mDenseIndex = static_cast<uint32_t>(mValues.size());
+        mValues.push_back(std::move(value));
+        mDenseToSlot.push_back(slotIndex);
+
+        return MakeHandle(slotIndex, slot.mGeneration);
+    }
+
+    bool Remove(uint32_t handle)
+    {
+        Slot* slot = FindSlot(handle);
+        if (slot == nullptr)
+        {
+            return false;
+        }
+        RemoveAt(slot->mDenseIndex);
+        return true;
+    }
+
+    // Swap-removes the value at a dense index, the last value moves into its place
+    void RemoveAt(size_t denseIndex)
+    {
+        uint32_t slotIndex = mDenseToSlot[denseIndex];
+        uint32_t lastSlotIndex = mDenseToSlot.back();
+
+        mValues[denseIndex] = std::move(mValues.back());
+        mDenseToSlot[denseIndex] = lastSlotIndex;
+        mSlots[lastSlotIndex].mDenseIndex = static_cast<uint32_t>(denseIndex);
+        mValues.pop_back();
+        mDenseToSlot.pop_back();
+
+        // Bumping the generation invalidates every outstanding handle to the slot
+        Slot& slot = mSlots[slotIndex];
+        slot.mGeneration = (slot.mGeneration + 1) & GENERATION_MASK;
+        if (slot.mGeneration == 0)
+        {
+            slot.mGeneration = 1;
+        }
+        mFreeSlots.push_back(slotIndex);
+    }
+
+    T* Get(uint32_t handle)
+    {
+        Slot* slot = FindSlot(handle);
+        return slot ? &mValues[slot->mDenseIndex] : nullptr;
+    }
+
+    bool Contains(uint32_t handle) const { return FindSlot(handle) != nullptr; }
+    void Clear()
+    {
+        while (!mValues.empty())
+        {
+            RemoveAt(mValues.size() - 1);
+        }
+    }
+
+    size_t Count() const { return mValues.size(); }
+    T& operator[](size_t denseIndex) { return mValues[denseIndex]; }
+    typename std::vector<T>::iterator begin() { return mValues.begin(); }
+    typename std::vector<T>::iterator end() { return mValues.end(); }
+
+private:
+    struct Slot
+    {
+        uint32_t mDenseIndex;
+        uint32_t mGeneration;
+    };
+
+    static uint32_t MakeHandle(uint32_t slotIndex, uint32_t generation)
+    {
+        return (generation << INDEX_BITS) | slotIndex;
+    }
+
+    Slot* FindSlot(uint32_t handle) const
+    {
+        uint32_t slotIndex = GetSlotIndex(handle);
+        uint32_t generation = handle >> INDEX_BITS;
+        if (handle == INVALID_HANDLE || slotIndex >= mSlots.size() || mSlots[slotIndex].mGeneration != generation)
+        {
+            return nullptr;
+        }
+        return const_cast<Slot*>(&mSlots[slotIndex]);
+    }
+
+    std::vector<T> mValues;
+    std::vector<uint32_t> mDenseToSlot;
+    std::vector<Slot> mSlots;
+    std::vector<uint32_t> mFreeSlots;
+};
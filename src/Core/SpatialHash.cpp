@@ -0,0 +1,146 @@
+// Includes
+//------------------------------------------------------------------------------
+// Core
+#include "SpatialHash.h"
+
+//------------------------------------------------------------------------------
+SpatialHash::SpatialHash(float cellSize)
+    : mCellSize(cellSize)
+{
+}
+
+//------------------------------------------------------------------------------
+void SpatialHash::Insert(GameObject* obj, const FloatRect& bounds, const FloatRect& previousBounds)
+{
+    if (mObjectRanges.find(obj) != mObjectRanges.end())
+    {
+        Update(obj, bounds, previousBounds);
+        return;
+    }
+
+    CellRange range = GetCellRange(bounds);
+    InsertIntoCells(obj, range, bounds, previousBounds);
+    mObjectRanges.emplace(obj, range);
+}
+
+//------------------------------------------------------------------------------
+void SpatialHash::Remove(GameObject* obj)
+{
+    auto itr = mObjectRanges.find(obj);
+    if (itr != mObjectRanges.end())
+    {
+        RemoveFromCells(obj, itr->second);
+        mObjectRanges.erase(itr);
+    }
+}
+
+//------------------------------------------------------------------------------
+void SpatialHash::Update(GameObject* obj, const FloatRect& bounds, const FloatRect& previousBounds)
+{
+    auto itr = mObjectRanges.find(obj);
+    if (itr == mObjectRanges.end())
+    {
+        return;
+    }
+
+    // Only reinsert when the object crosses into different cells, otherwise refresh the stored hitbox
+    CellRange range = GetCellRange(bounds);
+    if (range == itr->second)
+    {
+        UpdateInCells(obj, range, bounds, previousBounds);
+        return;
+    }
+
+    RemoveFromCells(obj, itr->second);
+    InsertIntoCells(obj, range, bounds, previousBounds);
+    itr->second = range;
+}
+
+//------------------------------------------------------------------------------
+void SpatialHash::Clear()
+{
+    mCells.clear();
+    mObjectRanges.clear();
+}
+
+//------------------------------------------------------------------------------
+void SpatialHash::QueryAABB(const FloatRect& area, std::vector<GameObject*>& result) const
+{
+    QueryAABB(area, [&result](GameObject* obj, const FloatRect&, const FloatRect&)
+    {
+        result.push_back(obj);
+    });
+}
+
+//------------------------------------------------------------------------------
+SpatialHash::CellRange SpatialHash::GetCellRange(const FloatRect& bounds) const
+{
+    return {
+        GetCellCoord(bounds.GetLeft()),
+        GetCellCoord(bounds.GetTop()),
+        GetCellCoord(bounds.GetRight()),
+        GetCellCoord(bounds.GetBottom())
+    };
+}
+
+//------------------------------------------------------------------------------
+void SpatialHash::InsertIntoCells(GameObject* obj, const CellRange& range, const FloatRect& bounds, const FloatRect& previousBounds)
+{
+    for (int32_t y = range.mMinY; y <= range.mMaxY; y++)
+    {
+        for (int32_t x = range.mMinX; x <= range.mMaxX; x++)
+        {
+            mCells[GetCellKey(x, y)].Add(obj, bounds, previousBounds);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void SpatialHash::UpdateInCells(GameObject* obj, const CellRange& range, const FloatRect& bounds, const FloatRect& previousBounds)
+{
+    for (int32_t y = range.mMinY; y <= range.mMaxY; y++)
+    {
+        for (int32_t x = range.mMinX; x <= range.mMaxX; x++)
+        {
+            auto itr = mCells.find(GetCellKey(x, y));
+            if (itr == mCells.end())
+            {
+                continue;
+            }
+
+            size_t index = itr->second.Find(obj);
+            if (index != HitboxStore::NOT_FOUND)
+            {
+                itr->second.Set(index, bounds, previousBounds);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void SpatialHash::RemoveFromCells(GameObject* obj, const CellRange& range)
+{
+    for (int32_t y = range.mMinY; y <= range.mMaxY; y++)
+    {
+        for (int32_t x = range.mMinX; x <= range.mMaxX; x++)
+        {
+            auto itr = mCells.find(GetCellKey(x, y));
+            if (itr == mCells.end())
+            {
+                continue;
+            }
+
+            HitboxStore& cell = itr->second;
+            size_t index = cell.Find(obj);
+            if (index != HitboxStore::NOT_FOUND)
+            {
+                cell.RemoveAt(index);
+            }
+
+            if (cell.IsEmpty())
+            {
+                mCells.erase(itr);
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+// Includes
+//------------------------------------------------------------------------------
+// Core
+#include "FloatRect.h"
+#include "HitboxStore.h"
+
+// System
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// Forward declarations
+//------------------------------------------------------------------------------
+class GameObject;
+
+//------------------------------------------------------------------------------
+class SpatialHash
+{
+    struct CellRange
+    {
+        int32_t mMinX;
+        int32_t mMinY;
+        int32_t mMaxX;
+        int32_t mMaxY;
+
+        bool operator==(const CellRange& other) const
+        {
+            return mMinX == other.mMinX && mMinY == other.mMinY && mMaxX == other.mMaxX && mMaxY == other.mMaxY;
+        }
+    };
+
+public:
+    explicit SpatialHash(float cellSize);
+
+    void Insert(GameObject* obj, const FloatRect& bounds) { Insert(obj, bounds, bounds); }
+    void Insert(GameObject* obj, const FloatRect& bounds, const FloatRect& previousBounds);
+    void Remove(GameObject* obj);
+    void Update(GameObject* obj, const FloatRect& bounds) { Update(obj, bounds, bounds); }
+    void Update(GameObject* obj, const FloatRect& bounds, const FloatRect& previousBounds);
+    void Clear();
+
+    // Calls callback(GameObject*, const FloatRect& bounds, const FloatRect& previousBounds) once for every
+    // object overlapping the area, the area is copied so the callback may move the rect it came from
+    template<typename Callback>
+    void QueryAABB(const FloatRect area, Callback callback) const
+    {
+        CellRange range = GetCellRange(area);
+        for (int32_t y = range.mMinY; y <= range.mMaxY; y++)
+        {
+            for (int32_t x = range.mMinX; x <= range.mMaxX; x++)
+            {
+                auto itr = mCells.find(GetCellKey(x, y));
+                if (itr == mCells.end())
+                {
+                    continue;
+                }
+
+                const HitboxStore& cell = itr->second;
+                cell.ForEachOverlap(area, mHits, [&](size_t index)
+                {
+                    // Objects spanning several cells are reported only from the cell holding the
+                    // top left corner of their overlap with the area
+                    FloatRect bounds = cell.GetHitbox(index);
+                    if (GetCellCoord(std::max(bounds.GetLeft(), area.GetLeft())) == x &&
+                        GetCellCoord(std::max(bounds.GetTop(), area.GetTop())) == y)
+                    {
+                        callback(cell.GetObject(index), bounds, cell.GetPreviousHitbox(index));
+                    }
+                });
+            }
+        }
+    }
+
+    // Appends every object whose hitbox overlaps the area, each object once
+    void QueryAABB(const FloatRect& area, std::vector<GameObject*>& result) const;
+
+private:
+    int32_t GetCellCoord(float position) const { return static_cast<int32_t>(std::floor(position / mCellSize)); }
+    CellRange GetCellRange(const FloatRect& bounds) const;
+    void InsertIntoCells(GameObject* obj, const CellRange& range, const FloatRect& bounds, const FloatRect& previousBounds);
+    void UpdateInCells(GameObject* obj, const CellRange& range, const FloatRect& bounds, const FloatRect& previousBounds);
+    void RemoveFromCells(GameObject* obj, const CellRange& range);
+
+    static uint64_t GetCellKey(int32_t x, int32_t y)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    }
+
+    float mCellSize;
+    std::unordered_map<uint64_t, HitboxStore> mCells;
+    mutable std::vector<uint64_t> mHits;
+    std::unordered_map<GameObject*, CellRange> mObjectRanges;
+};
@@ -2,8 +2,17 @@
 
 // Includes
 //------------------------------------------------------------------------------
+// Core
+#include "Bitmask.h"
+
 // System
 #include <algorithm>
+#include <cmath>
+#include <optional>
+
+//------------------------------------------------------------------------------
+// Below one word per row, extracting and shifting rows costs more than sampling the pixels
+constexpr int32_t ROW_COMPARE_MIN_WIDTH = 64;
 
 //------------------------------------------------------------------------------
 sf::IntRect GetTransformedBounds(const sf::Transformable& transformable, const sf::Vector2u size)
@@ -13,38 +22,81 @@ sf::IntRect GetTransformedBounds(const sf::Transformable& transformable, const s
 }
 
 //------------------------------------------------------------------------------
-sf::Image CreateImageFromTexture(const sf::Texture& texture, const sf::IntRect& textureRect)
+std::optional<sf::Vector2i> GetPixelOffset(const sf::Transform& inverseTransform)
+{
+    // Only pure translations map whole rows onto whole rows
+    const float* matrix = inverseTransform.getMatrix();
+    if (matrix[0] != 1.0f || matrix[1] != 0.0f || matrix[4] != 0.0f || matrix[5] != 1.0f)
+    {
+        return std::nullopt;
+    }
+    return sf::Vector2i(static_cast<int32_t>(std::floor(matrix[12])), static_cast<int32_t>(std::floor(matrix[13])));
+}
+
+//------------------------------------------------------------------------------
+bool CompareRows(const Bitmask& bitmask1,
+                 const Bitmask& bitmask2,
+                 const sf::IntRect& compareBounds,
+                 const sf::Vector2i& offset1,
+                 const sf::Vector2i& offset2)
 {
-    if (texture.getSize() != sf::Vector2u(textureRect.getSize()))
+    // Scratch rows are reused between calls and only grow for wider compares
+    static thread_local std::vector<uint64_t> row1;
+    static thread_local std::vector<uint64_t> row2;
+    uint32_t wordCount = (static_cast<uint32_t>(compareBounds.width) + 63) / 64;
+    row1.resize(wordCount);
+    row2.resize(wordCount);
+    uint32_t tailBits = static_cast<uint32_t>(compareBounds.width) % 64;
+    uint64_t tailMask = tailBits == 0 ? ~uint64_t(0) : (uint64_t(1) << tailBits) - 1;
+
+    for (int32_t y = compareBounds.top; y < compareBounds.top + compareBounds.height; ++y)
     {
-        sf::RenderTexture renderTexture;
-        if (!renderTexture.create(sf::Vector2u(textureRect.getSize())))
+        int32_t localY1 = y + offset1.y;
+        int32_t localY2 = y + offset2.y;
+        if (localY1 < 0 || localY2 < 0 || 
+            localY1 >= static_cast<int32_t>(bitmask1.GetSize().y) || localY2 >= static_cast<int32_t>(bitmask2.GetSize().y))
         {
-            throw std::runtime_error("Render texture creation failed");
+            continue;
         }
 
-        // Preserve source alpha chanel
-        sf::BlendMode blendMode(sf::BlendMode::Factor::SrcColor, sf::BlendMode::Factor::Zero);
+        // Shift both rows onto the compare bounds and test 64 pixels per word
+        bitmask1.ExtractRow(localY1, compareBounds.left + offset1.x, wordCount, row1.data());
+        bitmask2.ExtractRow(localY2, compareBounds.left + offset2.x, wordCount, row2.data());
+        row1.back() &= tailMask;
 
-        renderTexture.clear();
-        renderTexture.draw(sf::Sprite(texture, textureRect), blendMode);
-        renderTexture.display();
-
-        return renderTexture.getTexture().copyToImage();
-    }
-    else
-    {
-        return texture.copyToImage();
+        if (IsAnyBitShared(row1.data(), row2.data(), wordCount))
+        {
+            return true;
+        }
     }
+    return false;
 }
 
 //------------------------------------------------------------------------------
-bool ComparePixels(const sf::Image& image1,
-                   const sf::Image& image2,
+bool ComparePixels(const Bitmask& bitmask1,
+                   const Bitmask& bitmask2,
                    const sf::IntRect& compareBounds,
                    const sf::Transform& inverseTransform1,
                    const sf::Transform& inverseTransform2)
 {
+    std::optional<sf::Vector2i> offset1 = GetPixelOffset(inverseTransform1);
+    std::optional<sf::Vector2i> offset2 = GetPixelOffset(inverseTransform2);
+    if (offset1 && offset2 && compareBounds.width >= ROW_COMPARE_MIN_WIDTH)
+    {
+        return CompareRows(bitmask1, bitmask2, compareBounds, *offset1, *offset2);
+    }
+
+    return CompareTransformedPixels(bitmask1, bitmask2, compareBounds, inverseTransform1, inverseTransform2);
+}
+
+//------------------------------------------------------------------------------
+bool CompareTransformedPixels(const Bitmask& bitmask1,
+                              const Bitmask& bitmask2,
+                              const sf::IntRect& compareBounds,
+                              const sf::Transform& inverseTransform1,
+                              const sf::Transform& inverseTransform2)
+{
+    // Rotated, scaled or flipped sprites sample every pixel through their transform
     for (int32_t y = compareBounds.top; y < compareBounds.top + compareBounds.height; ++y)
     {
         for (int32_t x = compareBounds.left; x < compareBounds.left + compareBounds.width; ++x)
@@ -53,21 +105,10 @@ bool ComparePixels(const sf::Image& image1,
             sf::Vector2i localPos1 = sf::Vector2i(inverseTransform1.transformPoint(globalPos));
             sf::Vector2i localPos2 = sf::Vector2i(inverseTransform2.transformPoint(globalPos));
 
-            sf::Vector2u imageSize1 = image1.getSize();
-            sf::Vector2u imageSize2 = image2.getSize();
-
-            bool isInImage1Bounds = (0 <= localPos1.x && localPos1.x < imageSize1.x && 0 <= localPos1.y && localPos1.y < imageSize1.y);
-            bool isInImage2Bounds = (0 <= localPos2.x && localPos2.x < imageSize2.x && 0 <= localPos2.y && localPos2.y < imageSize2.y);
-
-            if (isInImage1Bounds && isInImage2Bounds)
+            // Out of bounds positions read as transparent
+            if (bitmask1.IsSolid(localPos1.x, localPos1.y) && bitmask2.IsSolid(localPos2.x, localPos2.y))
             {
-                sf::Color pixel1 = image1.getPixel(sf::Vector2u(localPos1));
-                sf::Color pixel2 = image2.getPixel(sf::Vector2u(localPos2));
-
-                if (pixel1.a != 0 && pixel2.a != 0)
-                {
-                    return true;
-                }
+                return true;
             }
         }
     }
@@ -82,12 +123,11 @@ bool BitmaskCompare(const sf::Texture& texture1,
                     const sf::IntRect& textureRect2,
                     const sf::Transformable& transformable2)
 {
+    const Bitmask& bitmask1 = BitmaskCache::Instance().GetBitmask(texture1, textureRect1);
+    const Bitmask& bitmask2 = BitmaskCache::Instance().GetBitmask(texture2, textureRect2);
 
-    sf::Image image1 = CreateImageFromTexture(texture1, textureRect1);
-    sf::Image image2 = CreateImageFromTexture(texture2, textureRect2);
-
-    sf::IntRect bounds1 = GetTransformedBounds(transformable1, image1.getSize());
-    sf::IntRect bounds2 = GetTransformedBounds(transformable2, image2.getSize());
+    sf::IntRect bounds1 = GetTransformedBounds(transformable1, bitmask1.GetSize());
+    sf::IntRect bounds2 = GetTransformedBounds(transformable2, bitmask2.GetSize());
 
     std::optional<sf::IntRect> compareBounds = bounds1.findIntersection(bounds2);
     if (!compareBounds)
@@ -95,8 +135,8 @@ bool BitmaskCompare(const sf::Texture& texture1,
         return false;
     }
 
-    return ComparePixels(image1,
-                         image2,
+    return ComparePixels(bitmask1,
+                         bitmask2,
                          compareBounds.value(),
                          transformable1.getInverseTransform(),
                          transformable2.getInverseTransform());
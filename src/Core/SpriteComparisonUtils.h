@@ -5,6 +5,10 @@
 // Third party
 #include <SFML/Graphics.hpp>
 
+// Forward declarations
+//------------------------------------------------------------------------------
+class Bitmask;
+
 //------------------------------------------------------------------------------
 bool BitmaskCompare(const sf::Texture& texture1,
                     const sf::IntRect& textureRect1,
@@ -12,4 +16,17 @@ bool BitmaskCompare(const sf::Texture& texture1,
                     const sf::Texture& texture2,
                     const sf::IntRect& textureRect2,
                     const sf::Transformable& transformable2);
-bool BitmaskCompare(const sf::Sprite& sprite1, const sf::Sprite& sprite2);
\ No newline at end of file
+bool BitmaskCompare(const sf::Sprite& sprite1, const sf::Sprite& sprite2);
+
+//------------------------------------------------------------------------------
+// Pixel tests over global compare bounds, ComparePixels takes the row path for pure translations
+bool ComparePixels(const Bitmask& bitmask1,
+                   const Bitmask& bitmask2,
+                   const sf::IntRect& compareBounds,
+                   const sf::Transform& inverseTransform1,
+                   const sf::Transform& inverseTransform2);
+bool CompareTransformedPixels(const Bitmask& bitmask1,
+                              const Bitmask& bitmask2,
+                              const sf::IntRect& compareBounds,
+                              const sf::Transform& inverseTransform1,
+                              const sf::Transform& inverseTransform2);
\ No newline at end of file
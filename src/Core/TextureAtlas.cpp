@@ -0,0 +1,94 @@
+#include "TextureAtlas.h"
+
+// Includes
+//------------------------------------------------------------------------------
+// System
+#include <algorithm>
+#include <stdexcept>
+
+//------------------------------------------------------------------------------
+TextureAtlas::TextureAtlas(uint32_t pageSize, uint32_t padding)
+    : mPageSize(pageSize)
+    , mPadding(padding)
+{ }
+
+//------------------------------------------------------------------------------
+TextureAtlasRegion TextureAtlas::Pack(const sf::Image& image)
+{
+    // Padding keeps neighbouring images from bleeding into each other
+    sf::Vector2u size(image.getSize().x + mPadding, image.getSize().y + mPadding);
+    sf::Vector2u position;
+
+    uint32_t pageIndex = 0;
+    while (pageIndex < mPages.size() && !TryPlace(mPages[pageIndex], size, position))
+    {
+        pageIndex++;
+    }
+
+    if (pageIndex == mPages.size())
+    {
+        Page& page = CreatePage(size);
+        TryPlace(page, size, position);
+    }
+
+    if (!mPages[pageIndex].mImage.copy(image, position))
+    {
+        throw std::runtime_error("Failed to copy image into texture atlas");
+    }
+
+    return { pageIndex, sf::IntRect(sf::Vector2i(position), sf::Vector2i(image.getSize())) };
+}
+
+//------------------------------------------------------------------------------
+void TextureAtlas::Upload()
+{
+    for (Page& page : mPages)
+    {
+        // Skip the unused rows below the last shelf
+        uint32_t usedHeight = std::min(page.mSize.y, page.mCursor.y + page.mShelfHeight);
+        sf::IntRect area({ 0, 0 }, sf::Vector2i(sf::Vector2u(page.mSize.x, usedHeight)));
+
+        page.mTexture = std::make_unique<sf::Texture>();
+        if (!page.mTexture->loadFromImage(page.mImage, area))
+        {
+            throw std::runtime_error("Failed to upload texture atlas page");
+        }
+        page.mImage = sf::Image();
+    }
+}
+
+//------------------------------------------------------------------------------
+bool TextureAtlas::TryPlace(Page& page, const sf::Vector2u& size, sf::Vector2u& position)
+{
+    // Shelf packing, start a new shelf when the current one is full
+    sf::Vector2u cursor = page.mCursor;
+    uint32_t shelfHeight = page.mShelfHeight;
+
+    if (cursor.x + size.x > page.mSize.x)
+    {
+        cursor = { 0, cursor.y + shelfHeight };
+        shelfHeight = 0;
+    }
+
+    if (cursor.x + size.x > page.mSize.x || cursor.y + size.y > page.mSize.y)
+    {
+        return false;
+    }
+
+    position = cursor;
+    page.mCursor = { cursor.x + size.x, cursor.y };
+    page.mShelfHeight = std::max(shelfHeight, size.y);
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+TextureAtlas::Page& TextureAtlas::CreatePage(const sf::Vector2u& minSize)
+{
+    // Oversized images get a page of their own
+    Page& page = mPages.emplace_back();
+    page.mSize = { std::max(mPageSize, minSize.x), std::max(mPageSize, minSize.y) };
+    page.mImage.create(page.mSize, sf::Color::Transparent);
+
+    return page;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+// Includes
+//------------------------------------------------------------------------------
+// Third party
+#include <SFML/Graphics.hpp>
+
+// System
+#include <memory>
+#include <vector>
+
+//------------------------------------------------------------------------------
+struct TextureAtlasRegion
+{
+    uint32_t mPage = 0;
+    sf::IntRect mRegion;
+};
+
+//------------------------------------------------------------------------------
+class TextureAtlas
+{
+public:
+    TextureAtlas(uint32_t pageSize = 2048, uint32_t padding = 2);
+
+    // Copies the image into a page, packing is done on the CPU only
+    TextureAtlasRegion Pack(const sf::Image& image);
+
+    // Creates one texture per page, must run on the thread owning the GL context
+    void Upload();
+
+    sf::Texture* GetTexture(uint32_t page) const { return mPages[page].mTexture.get(); }
+    size_t GetPageCount() const { return mPages.size(); }
+
+private:
+    struct Page
+    {
+        sf::Image mImage;
+        sf::Vector2u mSize;
+        sf::Vector2u mCursor;
+        uint32_t mShelfHeight = 0;
+        std::unique_ptr<sf::Texture> mTexture;
+    };
+
+    bool TryPlace(Page& page, const sf::Vector2u& size, sf::Vector2u& position);
+    Page& CreatePage(const sf::Vector2u& minSize);
+
+    std::vector<Page> mPages;
+    uint32_t mPageSize;
+    uint32_t mPadding;
+};
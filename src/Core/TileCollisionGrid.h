@@ -0,0 +1,119 @@
+#pragma once
+
+// Includes
+//------------------------------------------------------------------------------
+// Third party
+#include <SFML/Graphics.hpp>
+
+// Core
+#include "FloatRect.h"
+#include "TileGridUtils.h"
+
+// System
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+//------------------------------------------------------------------------------
+class TileCollisionGrid
+{
+public:
+    TileCollisionGrid() = default;
+
+    TileCollisionGrid(const std::vector<bool>& solidMask, const sf::Vector2u& gridSize, const sf::Vector2f& tileSize)
+        : mGridSize(gridSize)
+        , mTileSize(tileSize)
+        , mCellRects(solidMask.size(), NO_RECT)
+    {
+        // Merged rectangles are reported instead of single cells so long runs resolve as one surface
+        for (const sf::IntRect& cells : MergeSolidCells(solidMask, gridSize))
+        {
+            int32_t rectIndex = static_cast<int32_t>(mRects.size());
+            mRects.emplace_back(sf::Vector2f(cells.left * tileSize.x, cells.top * tileSize.y),
+                                sf::Vector2f(cells.width * tileSize.x, cells.height * tileSize.y));
+
+            for (int32_t y = cells.top; y < cells.top + cells.height; y++)
+            {
+                for (int32_t x = cells.left; x < cells.left + cells.width; x++)
+                {
+                    mCellRects[y * mGridSize.x + x] = rectIndex;
+                }
+            }
+        }
+        mRectQueryStamps.resize(mRects.size(), 0);
+    }
+
+    bool IsSolid(const sf::Vector2f& point) const
+    {
+        if (point.x < 0.0f || point.y < 0.0f)
+        {
+            return false;
+        }
+
+        uint32_t x = static_cast<uint32_t>(point.x / mTileSize.x);
+        uint32_t y = static_cast<uint32_t>(point.y / mTileSize.y);
+        return x < mGridSize.x && y < mGridSize.y && mCellRects[y * mGridSize.x + x] != NO_RECT;
+    }
+
+    // Calls callback(const FloatRect&) once per solid rectangle overlapping the area
+    template<typename Callback>
+    void QueryAABB(const FloatRect& area, Callback callback) const
+    {
+        if (mRects.empty())
+        {
+            return;
+        }
+
+        int32_t firstX = std::max(static_cast<int32_t>(std::floor(area.GetLeft() / mTileSize.x)), 0);
+        int32_t firstY = std::max(static_cast<int32_t>(std::floor(area.GetTop() / mTileSize.y)), 0);
+        int32_t lastX = std::min(static_cast<int32_t>(std::floor(area.GetRight() / mTileSize.x)), 
+                                 static_cast<int32_t>(mGridSize.x) - 1);
+        int32_t lastY = std::min(static_cast<int32_t>(std::floor(area.GetBottom() / mTileSize.y)), 
+                                 static_cast<int32_t>(mGridSize.y) - 1);
+
+        // Stamps skip rectangles already reported by an earlier cell of this query
+        if (++mQueryStamp == 0)
+        {
+            std::fill(mRectQueryStamps.begin(), mRectQueryStamps.end(), 0);
+            mQueryStamp = 1;
+        }
+
+        for (int32_t y = firstY; y <= lastY; y++)
+        {
+            for (int32_t x = firstX; x <= lastX; x++)
+            {
+                int32_t rectIndex = mCellRects[y * mGridSize.x + x];
+                if (rectIndex == NO_RECT || mRectQueryStamps[rectIndex] == mQueryStamp)
+                {
+                    continue;
+                }
+
+                mRectQueryStamps[rectIndex] = mQueryStamp;
+                if (area.FindIntersection(mRects[rectIndex]))
+                {
+                    callback(mRects[rectIndex]);
+                }
+            }
+        }
+    }
+
+    bool IsOverlapping(const FloatRect& area) const
+    {
+        bool isOverlapping = false;
+        QueryAABB(area, [&isOverlapping](const FloatRect&) { isOverlapping = true; });
+        return isOverlapping;
+    }
+
+    const sf::Vector2u& GetGridSize() const { return mGridSize; }
+    const sf::Vector2f& GetTileSize() const { return mTileSize; }
+
+private:
+    static constexpr int32_t NO_RECT = -1;
+
+    sf::Vector2u mGridSize;
+    sf::Vector2f mTileSize;
+    std::vector<int32_t> mCellRects;
+    std::vector<FloatRect> mRects;
+    mutable std::vector<uint32_t> mRectQueryStamps;
+    mutable uint32_t mQueryStamp = 0;
+};
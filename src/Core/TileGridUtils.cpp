@@ -0,0 +1,73 @@
+// Includes
+//------------------------------------------------------------------------------
+#include "TileGridUtils.h"
+
+//------------------------------------------------------------------------------
+std::vector<bool> CreateSolidMask(const ArrayView<uint16_t>& tileGrid)
+{
+    std::vector<bool> solidMask(tileGrid.size());
+    for (size_t index = 0; index < tileGrid.size(); index++)
+    {
+        solidMask[index] = tileGrid[index] != 0;
+    }
+    return solidMask;
+}
+
+//------------------------------------------------------------------------------
+std::vector<sf::IntRect> MergeSolidCells(const std::vector<bool>& solidMask, const sf::Vector2u& gridSize)
+{
+    // Greedy meshing: grow each rectangle right as far as possible, then down while full rows match
+    std::vector<sf::IntRect> rects;
+    std::vector<bool> isMerged(solidMask.size(), false);
+
+    auto isFree = [&](uint32_t x, uint32_t y)
+    {
+        size_t index = static_cast<size_t>(y) * gridSize.x + x;
+        return solidMask[index] && !isMerged[index];
+    };
+
+    for (uint32_t y = 0; y < gridSize.y; y++)
+    {
+        for (uint32_t x = 0; x < gridSize.x; x++)
+        {
+            if (!isFree(x, y))
+            {
+                continue;
+            }
+
+            uint32_t width = 1;
+            while (x + width < gridSize.x && isFree(x + width, y))
+            {
+                width++;
+            }
+
+            uint32_t height = 1;
+            while (y + height < gridSize.y)
+            {
+                bool isRowFree = true;
+                for (uint32_t offset = 0; offset < width && isRowFree; offset++)
+                {
+                    isRowFree = isFree(x + offset, y + height);
+                }
+
+                if (!isRowFree)
+                {
+                    break;
+                }
+                height++;
+            }
+
+            for (uint32_t row = y; row < y + height; row++)
+            {
+                for (uint32_t column = x; column < x + width; column++)
+                {
+                    isMerged[static_cast<size_t>(row) * gridSize.x + column] = true;
+                }
+            }
+
+            rects.emplace_back(sf::Vector2i(x, y), sf::Vector2i(width, height));
+        }
+    }
+
+    return rects;
+}
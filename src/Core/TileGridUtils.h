@@ -0,0 +1,17 @@
+#pragma once
+
+// Includes
+//------------------------------------------------------------------------------
+// Third party
+#include <SFML/Graphics.hpp>
+
+// Core
+#include "Core/ArrayView.h"
+
+// System
+#include <cstdint>
+#include <vector>
+
+//------------------------------------------------------------------------------
+std::vector<bool> CreateSolidMask(const ArrayView<uint16_t>& tileGrid);
+std::vector<sf::IntRect> MergeSolidCells(const std::vector<bool>& solidMask, const sf::Vector2u& gridSize);
@@ -9,14 +9,30 @@
 // Core
 #include "Core/ResourceManager.h"
 #include "Core/CustomExceptions.h"
+#include "Core/RectUtils.h"
+#include "Core/BinaryStream.h"
+#include "Core/MappedFile.h"
+#include "Core/TextureAtlas.h"
+#include "Core/Bitmask.h"
 
 // System 
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <set>
+#include <variant>
 
 
 
 namespace fs = std::filesystem;
 
+//------------------------------------------------------------------------------
+constexpr uint32_t TILED_MAP_COOKED_MAGIC = 0x4D575053;  // "SPWM"
+constexpr uint32_t TILED_MAP_COOKED_VERSION = 4;         // Bump when the cooked layout changes
+
 //------------------------------------------------------------------------------
 template<typename T>
 sf::Rect<T> ConvertToSFMLRect(const tson::Rect& rect)
@@ -55,11 +71,90 @@ enum class TiledMapObjectType
     Object = 1
 };
 
+//------------------------------------------------------------------------------
+class TiledMapPropertyCollection
+{
+    using Value = std::variant<bool, int32_t, float, std::string>;
+
+public:
+    TiledMapPropertyCollection(tson::PropertyCollection& properties)
+    {
+        for (auto& [name, property] : properties.getProperties())
+        {
+            switch (property.getType())
+            {
+                case tson::Type::Boolean: mValues.emplace(name, property.getValue<bool>()); break;
+                case tson::Type::Int: mValues.emplace(name, static_cast<int32_t>(property.getValue<int>())); break;
+                case tson::Type::Float: mValues.emplace(name, property.getValue<float>()); break;
+                case tson::Type::String: mValues.emplace(name, property.getValue<std::string>()); break;
+                case tson::Type::File: mValues.emplace(name, property.getValue<fs::path>().generic_string()); break;
+                default: break;  // Colors, classes and object references are not used by the game
+            }
+        }
+    }
+
+    TiledMapPropertyCollection(BinaryReader& reader)
+    {
+        uint32_t count = reader.Read<uint32_t>();
+        for (uint32_t index = 0; index < count; index++)
+        {
+            std::string name = reader.ReadString();
+            switch (reader.Read<uint8_t>())
+            {
+                case 0: mValues.emplace(name, reader.Read<bool>()); break;
+                case 1: mValues.emplace(name, reader.Read<int32_t>()); break;
+                case 2: mValues.emplace(name, reader.Read<float>()); break;
+                case 3: mValues.emplace(name, reader.ReadString()); break;
+                default: throw std::runtime_error("Unknown cooked property type: " + name);
+            }
+        }
+    }
+
+    void Write(BinaryWriter& writer) const
+    {
+        writer.Write(static_cast<uint32_t>(mValues.size()));
+        for (const auto& [name, value] : mValues)
+        {
+            writer.WriteString(name);
+            writer.Write(static_cast<uint8_t>(value.index()));
+            std::visit([&writer](const auto& typedValue) 
+            {
+                if constexpr (std::is_same_v<std::decay_t<decltype(typedValue)>, std::string>)
+                {
+                    writer.WriteString(typedValue);
+                }
+                else
+                {
+                    writer.Write(typedValue);
+                }
+            }, value);
+        }
+    }
+
+    template<typename T>
+    T GetValue(const std::string& name) const
+    {
+        // Missing or mistyped properties yield a default value, matching tileson
+        auto itr = mValues.find(name);
+        if (itr != mValues.end())
+        {
+            if (const T* value = std::get_if<T>(&itr->second))
+            {
+                return *value;
+            }
+        }
+        return T();
+    }
+
+private:
+    std::unordered_map<std::string, Value> mValues;
+};
+
 //------------------------------------------------------------------------------
 class TiledMapObject
 {
 public:
-    TiledMapObject(tson::Object& object, tson::Layer& layer)
+    TiledMapObject(tson::Object& object)
         : mType(TiledMapObjectType::Unknown)
         , mGid(0)        
         , mScale(1.0f, 1.0f)
@@ -75,7 +170,6 @@ public:
         {
             mType = TiledMapObjectType::Object;
             mGid = object.getGid();
-            ComputeTextureRegion(layer);
             
             mPosition.y -= object.getSize().y;  // Account for y origin of tile object
         }
@@ -92,9 +186,29 @@ public:
         }
     }
 
+    TiledMapObject(BinaryReader& reader)
+        : mType(static_cast<TiledMapObjectType>(reader.Read<uint32_t>()))
+        , mGid(reader.Read<uint32_t>())
+        , mPosition(reader.Read<sf::Vector2f>())
+        , mScale(reader.Read<sf::Vector2f>())
+        , mSize(reader.Read<sf::Vector2f>())
+        , mName(reader.ReadString())
+        , mPropertyCollection(reader)
+    { }
+
+    void Write(BinaryWriter& writer) const
+    {
+        writer.Write(static_cast<uint32_t>(mType));
+        writer.Write(mGid);
+        writer.Write(mPosition);
+        writer.Write(mScale);
+        writer.Write(mSize);
+        writer.WriteString(mName);
+        mPropertyCollection.Write(writer);
+    }
+
     TiledMapObjectType GetType() const { return mType; }
     uint32_t GetGid() const { return mGid; }
-    const sf::IntRect& GetTextureRegion() const { return mTextureRegion; }
     const sf::Vector2f& GetPosition() const { return mPosition; }    
     const sf::Vector2f& GetScale() const { return mScale; }
     const sf::Vector2f& GetSize() const { return mSize; }
@@ -103,27 +217,17 @@ public:
     template<typename T>
     T GetPropertyValue(const std::string& name) const
     {
-        //Remove const to call method
-        return const_cast<TiledMapObject*>(this)->mPropertyCollection.getValue<T>(name);
+        return mPropertyCollection.GetValue<T>(name);
     }
 
 private:
-    void ComputeTextureRegion(tson::Layer& layer)
-    {
-        tson::Tileset* tileset = layer.getMap()->getTilesetByGid(mGid);
-        uint32_t id = mGid - tileset->getFirstgid() + 1;
-        tson::Tile* tile = tileset->getTile(id);
-        mTextureRegion = sf::IntRect(ConvertToSFMLRect<float>(tile->getDrawingRect()));        
-    }
-
     TiledMapObjectType mType;
     uint32_t mGid;
-    sf::IntRect mTextureRegion;
     sf::Vector2f mPosition;
     sf::Vector2f mScale;
     sf::Vector2f mSize;
     std::string mName;
-    tson::PropertyCollection mPropertyCollection;
+    TiledMapPropertyCollection mPropertyCollection;
 };
 
 //------------------------------------------------------------------------------
@@ -154,10 +258,32 @@ public:
         }
     }
 
+    TiledMapTile(BinaryReader& reader)
+        : mId(reader.Read<uint32_t>())
+        , mGid(reader.Read<uint32_t>())
+        , mTextureRegion(reader.Read<sf::IntRect>())
+        , mTextureRelativeFilepath(reader.ReadString())
+        , mScale(reader.Read<sf::Vector2f>())
+    { }
+
+    void Write(BinaryWriter& writer) const
+    {
+        writer.Write(mId);
+        writer.Write(mGid);
+        writer.Write(mTextureRegion);
+        writer.WriteString(mTextureRelativeFilepath.generic_string());
+        writer.Write(mScale);
+    }
+
     uint32_t GetId() const { return mId; }
     uint32_t GetGid() const { return mGid; }
     const sf::IntRect& GetTextureRegion() const { return mTextureRegion; }    
     fs::path GetTextureRelativeFilepath() const { return mTextureRelativeFilepath; }    
+    void OffsetTextureRegion(const sf::Vector2i& offset)
+    {
+        mTextureRegion.left += offset.x;
+        mTextureRegion.top += offset.y;
+    }
     const sf::Vector2f& GetScale() const { return mScale; }
 
 private:
@@ -197,9 +323,32 @@ public:
         }
     }
 
+    TiledMapTileset(BinaryReader& reader)
+        : mType(static_cast<TiledMapTilesetType>(reader.Read<uint32_t>()))
+        , mTextureRelativeFilepath(reader.ReadString())
+    {
+        uint32_t tileCount = reader.ReadCount(sizeof(uint32_t));
+        mTiles.reserve(tileCount);
+        for (uint32_t index = 0; index < tileCount; index++)
+        {
+            mTiles.emplace_back(reader);
+        }
+    }
+
+    void Write(BinaryWriter& writer) const
+    {
+        writer.Write(static_cast<uint32_t>(mType));
+        writer.WriteString(mTextureRelativeFilepath.generic_string());
+        writer.Write(static_cast<uint32_t>(mTiles.size()));
+        for (const TiledMapTile& tile : mTiles)
+        {
+            tile.Write(writer);
+        }
+    }
+
     std::vector<TiledMapTile>& GetTiles() { return mTiles; }
 
-    void LoadTextures(std::unordered_map<uint32_t, sf::Texture*>& textureLookup)
+    void LoadTextures(std::vector<sf::Texture*>& textureLookup)
     {
         TextureManager& textureManager = ResourceLocator::GetInstance().GetTextureManager();
         
@@ -216,19 +365,7 @@ public:
                 textureLookup[tile.GetGid()] = texture;
             }
         }
-        else if (mType == TiledMapTilesetType::ImageCollectionTileset)
-        {
-            for (TiledMapTile& tile : mTiles)
-            {                       
-                if (!textureManager.RequireResource(tile.GetTextureRelativeFilepath().string()))
-                {
-                    assert(false);
-                }
-             
-                sf::Texture* texture = textureManager.GetResource(tile.GetTextureRelativeFilepath().string());
-                textureLookup[tile.GetGid()] = texture;                
-            }
-        }
+        // Image collections are packed into the map texture atlas
     }
 
     void UnloadTextures()
@@ -239,42 +376,51 @@ public:
         {
             textureManager.ReleaseResource(mTextureRelativeFilepath.string());            
         }
-        else if (mType == TiledMapTilesetType::ImageCollectionTileset)
-        {
-            for (TiledMapTile& tile : mTiles)
-            {
-                textureManager.RequireResource(tile.GetTextureRelativeFilepath().string());                                
-            }
-        }
     }
 
+    TiledMapTilesetType GetType() const { return mType; }
+    const fs::path& GetTextureRelativeFilepath() const { return mTextureRelativeFilepath; }
+
 private:
-    std::vector<TiledMapTile> mTiles;
-    fs::path mTextureRelativeFilepath;
     TiledMapTilesetType mType;
+    fs::path mTextureRelativeFilepath;
+    std::vector<TiledMapTile> mTiles;
 };
 
+//------------------------------------------------------------------------------
+using TiledMapTileIndex = uint16_t;  // Tile gid, 0 marks an empty cell
+
 //------------------------------------------------------------------------------
 class TiledMapLayer
 {
 public:
-    TiledMapLayer(tson::Layer& layer, std::unordered_map<uint32_t, TiledMapTile*> tileMap)
-        : mTileCount(ConvertToSFMLVector2f(layer.getSize()))
-        , mType(TiledMapLayerType::Unknown)
+    TiledMapLayer(tson::Layer& layer)
+        : mType(TiledMapLayerType::Unknown)
         , mName(layer.getName())
+        , mTileCount(ConvertToSFMLVector2f(layer.getSize()))
     {
         if (layer.getType() == tson::LayerType::TileLayer)
-        {      
+        {
+            mOwnedTileGrid.resize(static_cast<size_t>(mTileCount.x) * mTileCount.y, 0);
+
             for (auto& [index, tile] : layer.getTileData())
             {
-                mTileData[index] = tileMap.at(tile->getGid());
+                if (tile->getGid() > std::numeric_limits<TiledMapTileIndex>::max())
+                {
+                    throw std::runtime_error("Tile gid out of range in layer: " + mName);
+                }
+
+                uint32_t x = static_cast<uint32_t>(std::get<0>(index));
+                uint32_t y = static_cast<uint32_t>(std::get<1>(index));
+                mOwnedTileGrid[y * mTileCount.x + x] = static_cast<TiledMapTileIndex>(tile->getGid());
             }
+            mTileGrid = mOwnedTileGrid;
         }
         else if (layer.getType() == tson::LayerType::ObjectGroup)
         {
             for (tson::Object& object : layer.getObjects())
             {
-                mObjects.emplace_back(object, layer);
+                mObjects.emplace_back(object);
             }
         }
 
@@ -288,93 +434,605 @@ public:
         }
     }
 
-    TiledMapTile* GetTile(uint32_t x, uint32_t y) const
-    { 
-        if (mTileData.count({ x, y }) > 0)
+    TiledMapLayer(BinaryReader& reader)
+        : mType(static_cast<TiledMapLayerType>(reader.Read<uint32_t>()))
+        , mName(reader.ReadString())
+        , mTileCount(reader.Read<sf::Vector2u>())
+        , mTileGrid(reader.ReadArrayView<TiledMapTileIndex>())
+    {
+        uint32_t objectCount = reader.ReadCount(sizeof(uint32_t));
+        mObjects.reserve(objectCount);
+        for (uint32_t index = 0; index < objectCount; index++)
+        {
+            mObjects.emplace_back(reader);
+        }
+    }
+
+    // The grid may view the owned tiles, so layers are moved but never copied
+    TiledMapLayer(const TiledMapLayer&) = delete;
+    TiledMapLayer& operator=(const TiledMapLayer&) = delete;
+    TiledMapLayer(TiledMapLayer&&) = default;
+    TiledMapLayer& operator=(TiledMapLayer&&) = default;
+
+    void Write(BinaryWriter& writer) const
+    {
+        writer.Write(static_cast<uint32_t>(mType));
+        writer.WriteString(mName);
+        writer.Write(mTileCount);
+        writer.WriteArray(mTileGrid);
+        writer.Write(static_cast<uint32_t>(mObjects.size()));
+        for (const TiledMapObject& object : mObjects)
         {
-            return mTileData.at({ x, y });
+            object.Write(writer);
         }
-        return nullptr;
     }
 
-    const std::map<std::tuple<int32_t, int32_t>, TiledMapTile*>& GetTileData() const { return mTileData; }
+    uint32_t GetTileGid(uint32_t x, uint32_t y) const
+    { 
+        return mTileGrid[y * mTileCount.x + x];
+    }
+
+    const ArrayView<TiledMapTileIndex>& GetTileGrid() const { return mTileGrid; }
     const std::vector<TiledMapObject>& GetObjects() const { return mObjects; }
     const sf::Vector2u& GetTileCount() const { return mTileCount; }
     TiledMapLayerType GetType() const { return mType; }
     const std::string& GetName() const { return mName; }
 
 private:
-    std::set<uint32_t> mUniqueFlaggedTiles;
-    std::vector<TiledMapObject> mObjects;
-    std::map<std::tuple<int32_t, int32_t>, TiledMapTile*> mTileData;
-    sf::Vector2u mTileCount;
     TiledMapLayerType mType;
     std::string mName;
+    sf::Vector2u mTileCount;
+    ArrayView<TiledMapTileIndex> mTileGrid;             // Row-major, views the owned tiles or the cooked file
+    std::vector<TiledMapTileIndex> mOwnedTileGrid;      // Only filled when loaded from JSON
+    std::vector<TiledMapObject> mObjects;
+};
+
+//------------------------------------------------------------------------------
+// A file the cooked blob was built from, with a stamp of its contents at cook time
+struct TiledMapSourceFile
+{
+    fs::path mRelativeFilepath;
+    uint64_t mSize;
+    uint64_t mContentHash;
 };
 
 //------------------------------------------------------------------------------
 class TiledMap
 {
 public:
-    TiledMap(fs::path mapFilepath)
+    TiledMap(fs::path mapFilepath, bool isCookedAllowed = true)
     {
         if (!mapFilepath.is_absolute())
         {
             mapFilepath = RESOURCES_PATH / mapFilepath;
         }
-        mapFilepath = fs::canonical(mapFilepath);
-        
-        tson::Tileson parser;
-        auto sourceData = parser.parse(mapFilepath.string());
+        mapFilepath = fs::weakly_canonical(mapFilepath);
 
-        for (tson::Tileset& tileset : sourceData->getTilesets())
+        // Prefer the cooked blob, fall back to the Tiled JSON source
+        fs::path cookedFilepath = GetCookedFilepath(mapFilepath);
+        if (isCookedAllowed && fs::exists(cookedFilepath) && LoadCooked(cookedFilepath))
         {
-            mTilesets.emplace_back(tileset, mapFilepath);
+            return;
+        }
 
-            for (TiledMapTile& tile : mTilesets.back().GetTiles())
-            {                
-                mTileMap.emplace(tile.GetGid(), &tile);
-            }
+        LoadJson(mapFilepath);
+    }
+
+    void SaveCooked(const fs::path& cookedFilepath) const
+    {
+        BinaryWriter writer;
+        writer.Write(TILED_MAP_COOKED_MAGIC);
+        writer.Write(TILED_MAP_COOKED_VERSION);
+        writer.Write(mTileSize);
+
+        writer.Write(static_cast<uint32_t>(mSourceFiles.size()));
+        for (const TiledMapSourceFile& sourceFile : mSourceFiles)
+        {
+            writer.WriteString(sourceFile.mRelativeFilepath.generic_string());
+            writer.Write(sourceFile.mSize);
+            writer.Write(sourceFile.mContentHash);
         }
 
-        for (tson::Layer& layer : sourceData->getLayers())
+        writer.Write(static_cast<uint32_t>(mTilesets.size()));
+        for (const TiledMapTileset& tileset : mTilesets)
         {
-            mLayers.emplace_back(layer, mTileMap);
+            tileset.Write(writer);
         }
 
-        mTileSize = ConvertToSFMLVector2f(sourceData->getTileSize());
+        writer.Write(static_cast<uint32_t>(mLayers.size()));
+        for (const TiledMapLayer& layer : mLayers)
+        {
+            layer.Write(writer);
+        }
 
-        sourceData.reset();
+        writer.SaveToFile(cookedFilepath);
     }
 
+    // Cooked blobs are build outputs, they mirror the resources folder layout under the cooked folder
+    static fs::path GetCookedFilepath(const fs::path& mapFilepath)
+    {
+        fs::path relativeFilepath = fs::relative(mapFilepath, RESOURCES_PATH);
+        return (COOKED_RESOURCES_PATH / relativeFilepath).replace_extension(".cooked");
+    }
+
+    // Decodes and packs tileset images on the CPU, safe to call from a worker thread
+    void PrepareTextures()
+    {
+        if (!mTextureAtlas)
+        {
+            PackTextureAtlas();
+        }
+    }
+
+    // Creates GPU textures, must run on the main thread
     void LoadTextures()
     {
+        mTextureLookup.assign(mTileLookup.size(), nullptr);
+
         for (TiledMapTileset& tileset : mTilesets)
         {
             tileset.LoadTextures(mTextureLookup);
         }
+
+        PrepareTextures();
+        UploadTextureAtlas();
     }
 
     void UnloadTextures()
     {
+        // Masks are keyed by texture address, which the next load may reuse
+        std::set<const sf::Texture*> textures(mTextureLookup.begin(), mTextureLookup.end());
+        for (const sf::Texture* texture : textures)
+        {
+            if (texture != nullptr)
+            {
+                BitmaskCache::Instance().Evict(*texture);
+            }
+        }
+
         for (TiledMapTileset& tileset : mTilesets)
         {
             tileset.UnloadTextures();            
         }
+
+        ReleaseTextureAtlas();
     }
        
-    sf::Texture* GetTetxure(uint32_t gid) const { return mTextureLookup.at(gid); }
+    const TiledMapTile* GetTile(uint32_t gid) const { return mTileLookup[gid]; }
+    sf::Texture* GetTetxure(uint32_t gid) const { return mTextureLookup[gid]; }
+    const sf::IntRect& GetTextureRegion(uint32_t gid) const { return mTextureRegionLookup[gid]; }
     const std::vector<TiledMapLayer>& GetLayers() const { return mLayers; }    
     const sf::Vector2f GetTileSize() const { return mTileSize; }
 
 private:
-    std::unordered_map<uint32_t, sf::Texture*> mTextureLookup;
-    std::unordered_map<uint32_t, TiledMapTile*> mTileMap;
+    void LoadJson(const fs::path& mapFilepath)
+    {
+        tson::Tileson parser;
+        auto sourceData = parser.parse(mapFilepath.string());
+
+        for (tson::Tileset& tileset : sourceData->getTilesets())
+        {
+            mTilesets.emplace_back(tileset, mapFilepath);
+        }
+
+        for (tson::Layer& layer : sourceData->getLayers())
+        {
+            mLayers.emplace_back(layer);
+        }
+
+        BuildTileLookup();
+
+        mTileSize = ConvertToSFMLVector2f(sourceData->getTileSize());
+
+        sourceData.reset();
+
+        CollectSourceFiles(mapFilepath);
+    }
+
+    // Files the cooked blob is built from, relative to the resources folder
+    void CollectSourceFiles(const fs::path& mapFilepath)
+    {
+        std::set<fs::path> sourceFilepaths;
+        sourceFilepaths.insert(fs::relative(mapFilepath, RESOURCES_PATH));
+
+        // The parsed map inlines external tilesets, so their paths come from the map's own tileset entries
+        tson::Json11 mapJson;
+        if (mapJson.parse(mapFilepath))
+        {
+            for (std::unique_ptr<tson::IJson>& tileset : mapJson.array("tilesets"))
+            {
+                if (tileset->count("source") > 0)
+                {
+                    fs::path tilesetFilepath = mapFilepath.parent_path() / tileset->get<std::string>("source");
+                    sourceFilepaths.insert(fs::relative(fs::weakly_canonical(tilesetFilepath), RESOURCES_PATH));
+                }
+            }
+        }
+
+        for (TiledMapTileset& tileset : mTilesets)
+        {
+            if (!tileset.GetTextureRelativeFilepath().empty())
+            {
+                sourceFilepaths.insert(tileset.GetTextureRelativeFilepath());
+            }
+            for (TiledMapTile& tile : tileset.GetTiles())
+            {
+                if (!tile.GetTextureRelativeFilepath().empty())
+                {
+                    sourceFilepaths.insert(tile.GetTextureRelativeFilepath());
+                }
+            }
+        }
+
+        for (const fs::path& sourceFilepath : sourceFilepaths)
+        {
+            mSourceFiles.push_back(ReadSourceFile(sourceFilepath));
+        }
+    }
+
+    bool LoadCooked(const fs::path& cookedFilepath)
+    {
+        try
+        {
+            // Tile grids view the mapping directly, so it stays open for the lifetime of the map
+            mCookedFile = std::make_unique<MappedFile>(cookedFilepath);
+            BinaryReader reader(mCookedFile->GetData(), mCookedFile->GetSize());
+
+            // Stale layouts are ignored so the JSON source is used instead
+            if (reader.Read<uint32_t>() != TILED_MAP_COOKED_MAGIC || reader.Read<uint32_t>() != TILED_MAP_COOKED_VERSION)
+            {
+                ClearMapData();
+                return false;
+            }
+
+            mTileSize = reader.Read<sf::Vector2f>();
+
+            uint32_t sourceCount = reader.ReadCount(sizeof(uint32_t) + 2 * sizeof(uint64_t));
+            for (uint32_t index = 0; index < sourceCount; index++)
+            {
+                TiledMapSourceFile sourceFile;
+                sourceFile.mRelativeFilepath = reader.ReadString();
+                sourceFile.mSize = reader.Read<uint64_t>();
+                sourceFile.mContentHash = reader.Read<uint64_t>();
+                if (!IsSourceFileCurrent(sourceFile))
+                {
+                    ClearMapData();
+                    return false;
+                }
+                mSourceFiles.push_back(std::move(sourceFile));
+            }
+
+            uint32_t tilesetCount = reader.ReadCount(sizeof(uint32_t));
+            mTilesets.reserve(tilesetCount);
+            for (uint32_t index = 0; index < tilesetCount; index++)
+            {
+                mTilesets.emplace_back(reader);
+            }
+
+            uint32_t layerCount = reader.ReadCount(sizeof(uint32_t));
+            mLayers.reserve(layerCount);
+            for (uint32_t index = 0; index < layerCount; index++)
+            {
+                mLayers.emplace_back(reader);
+            }
+        }
+        catch (const std::runtime_error&)
+        {
+            // Truncated or corrupt blobs are treated like stale ones
+            ClearMapData();
+            return false;
+        }
+
+        BuildTileLookup();
+
+        return true;
+    }
+
+    void ClearMapData()
+    {
+        mSourceFiles.clear();
+        mTilesets.clear();
+        mLayers.clear();
+        mCookedFile.reset();
+        mTileSize = sf::Vector2f();
+    }
+
+    static TiledMapSourceFile ReadSourceFile(const fs::path& relativeFilepath)
+    {
+        // FNV-1a over the contents, so copies and checkouts that only touch timestamps keep the blob valid
+        TiledMapSourceFile sourceFile{ relativeFilepath, 0, 14695981039346656037ull };
+        std::ifstream file(RESOURCES_PATH / relativeFilepath, std::ios::binary);
+        char buffer[4096];
+        while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+        {
+            for (std::streamsize index = 0; index < file.gcount(); index++)
+            {
+                sourceFile.mContentHash = (sourceFile.mContentHash ^ static_cast<uint8_t>(buffer[index])) * 1099511628211ull;
+            }
+            sourceFile.mSize += static_cast<uint64_t>(file.gcount());
+        }
+        return sourceFile;
+    }
+
+    static bool IsSourceFileCurrent(const TiledMapSourceFile& sourceFile)
+    {
+#if PRODUCTION_BUILD
+        return true;  // Shipped maps are cooked at build time
+#else
+        // Sources edited since the last cook are loaded from JSON
+        if (!fs::exists(RESOURCES_PATH / sourceFile.mRelativeFilepath))
+        {
+            return true;
+        }
+
+        TiledMapSourceFile currentFile = ReadSourceFile(sourceFile.mRelativeFilepath);
+        return currentFile.mSize == sourceFile.mSize && currentFile.mContentHash == sourceFile.mContentHash;
+#endif
+    }
+
+    void PackTextureAtlas()
+    {
+        mTextureAtlas = std::make_unique<TextureAtlas>();
+
+        for (TiledMapTileset& tileset : mTilesets)
+        {
+            if (tileset.GetType() != TiledMapTilesetType::ImageCollectionTileset)
+            {
+                continue;
+            }
+
+            for (TiledMapTile& tile : tileset.GetTiles())
+            {
+                sf::Image image;
+                if (!image.loadFromFile(RESOURCES_PATH / tile.GetTextureRelativeFilepath()))
+                {
+                    throw std::runtime_error("Failed to load resource: " + tile.GetTextureRelativeFilepath().string());
+                }
+
+                // Point the tile into its atlas page
+                TextureAtlasRegion atlasRegion = mTextureAtlas->Pack(image);
+                tile.OffsetTextureRegion(atlasRegion.mRegion.getPosition());
+                mTextureRegionLookup[tile.GetGid()] = tile.GetTextureRegion();
+                mAtlasTiles.emplace_back(&tile, atlasRegion);
+            }
+        }
+    }
+
+    void UploadTextureAtlas()
+    {
+        mTextureAtlas->Upload();
+
+        for (auto& [tile, atlasRegion] : mAtlasTiles)
+        {
+            mTextureLookup[tile->GetGid()] = mTextureAtlas->GetTexture(atlasRegion.mPage);
+        }
+    }
+
+    void ReleaseTextureAtlas()
+    {
+        if (mTextureAtlas)
+        {
+            for (size_t page = 0; page < mTextureAtlas->GetPageCount(); page++)
+            {
+                sf::Texture* texture = mTextureAtlas->GetTexture(static_cast<uint32_t>(page));
+                if (texture != nullptr)
+                {
+                    BitmaskCache::Instance().Evict(*texture);
+                }
+            }
+        }
+
+        for (auto& [tile, atlasRegion] : mAtlasTiles)
+        {
+            tile->OffsetTextureRegion(-atlasRegion.mRegion.getPosition());
+            mTextureRegionLookup[tile->GetGid()] = tile->GetTextureRegion();
+            mTextureLookup[tile->GetGid()] = nullptr;
+        }
+
+        mAtlasTiles.clear();
+        mTextureAtlas.reset();
+    }
+
+    void BuildTileLookup()
+    {
+        uint32_t maxGid = 0;
+        for (TiledMapTileset& tileset : mTilesets)
+        {
+            for (TiledMapTile& tile : tileset.GetTiles())
+            {
+                maxGid = std::max(maxGid, tile.GetGid());
+            }
+        }
+
+        // Flat arrays indexed by gid, slot 0 is the empty tile
+        mTileLookup.assign(maxGid + 1, nullptr);
+        mTextureRegionLookup.assign(maxGid + 1, sf::IntRect());
+
+        for (TiledMapTileset& tileset : mTilesets)
+        {
+            for (TiledMapTile& tile : tileset.GetTiles())
+            {
+                mTileLookup[tile.GetGid()] = &tile;
+                mTextureRegionLookup[tile.GetGid()] = tile.GetTextureRegion();
+            }
+        }
+    }
+
+    std::vector<TiledMapTile*> mTileLookup;
+    std::vector<sf::Texture*> mTextureLookup;
+    std::vector<sf::IntRect> mTextureRegionLookup;
+    std::unique_ptr<TextureAtlas> mTextureAtlas;
+    std::vector<std::pair<TiledMapTile*, TextureAtlasRegion>> mAtlasTiles;
+    std::unique_ptr<MappedFile> mCookedFile;    // Declared first so it outlives the layers viewing it
     std::vector<TiledMapTileset> mTilesets;
     std::vector<TiledMapLayer> mLayers;
+    std::vector<TiledMapSourceFile> mSourceFiles;
     sf::Vector2f mTileSize;
 };
 
+//------------------------------------------------------------------------------
+constexpr uint32_t TILED_MAP_CHUNK_SIZE = 16;  // Tiles per chunk side
+
+//------------------------------------------------------------------------------
+class TiledMapTileChunk
+{
+public:
+    void AddTile(const sf::Texture* texture, const sf::Vector2f& position, const sf::Vector2f& size, 
+                 const sf::IntRect& textureRegion)
+    {
+        sf::VertexArray& vertices = GetBatch(texture);
+        ExpandBounds(sf::FloatRect(position, size));
+
+        sf::Vector2f texCoords(textureRegion.getPosition());
+        sf::Vector2f texSize(textureRegion.getSize());
+
+        sf::Vertex topLeft{ position, sf::Color::White, texCoords };
+        sf::Vertex topRight{ { position.x + size.x, position.y }, sf::Color::White, { texCoords.x + texSize.x, texCoords.y } };
+        sf::Vertex bottomLeft{ { position.x, position.y + size.y }, sf::Color::White, { texCoords.x, texCoords.y + texSize.y } };
+        sf::Vertex bottomRight{ position + size, sf::Color::White, texCoords + texSize };
+
+        // Two triangles per tile
+        vertices.append(topLeft);
+        vertices.append(topRight);
+        vertices.append(bottomLeft);
+        vertices.append(bottomLeft);
+        vertices.append(topRight);
+        vertices.append(bottomRight);
+    }
+
+    void Draw(sf::RenderTarget& target) const
+    {
+        for (const auto& [texture, vertices] : mBatches)
+        {
+            target.draw(vertices, sf::RenderStates(texture));
+        }
+    }
+
+    bool IsEmpty() const { return mBatches.empty(); }
+    const sf::FloatRect& GetBounds() const { return mBounds; }
+
+private:
+    void ExpandBounds(sf::FloatRect rect)
+    {
+        // Normalize flipped quads
+        if (rect.width < 0.0f) { rect.left += rect.width; rect.width = -rect.width; }
+        if (rect.height < 0.0f) { rect.top += rect.height; rect.height = -rect.height; }
+
+        if (IsEmpty())
+        {
+            mBounds = rect;
+            return;
+        }
+
+        float left = std::min(mBounds.left, rect.left);
+        float top = std::min(mBounds.top, rect.top);
+        float right = std::max(mBounds.left + mBounds.width, rect.left + rect.width);
+        float bottom = std::max(mBounds.top + mBounds.height, rect.top + rect.height);
+        mBounds = sf::FloatRect({ left, top }, { right - left, bottom - top });
+    }
+
+    sf::VertexArray& GetBatch(const sf::Texture* texture)
+    {
+        for (auto& [batchTexture, vertices] : mBatches)
+        {
+            if (batchTexture == texture)
+            {
+                return vertices;
+            }
+        }
+        
+        mBatches.emplace_back(texture, sf::VertexArray(sf::PrimitiveType::Triangles));
+        return mBatches.back().second;
+    }
+
+    // One vertex array per texture, a chunk typically uses a handful of textures
+    std::vector<std::pair<const sf::Texture*, sf::VertexArray>> mBatches;
+    sf::FloatRect mBounds;
+};
+
+//------------------------------------------------------------------------------
+class TiledMapTileLayerMesh
+{
+public:
+    TiledMapTileLayerMesh(const sf::Vector2u& tileCount, const sf::Vector2f& tileSize)
+        : mChunkCount((tileCount.x + TILED_MAP_CHUNK_SIZE - 1) / TILED_MAP_CHUNK_SIZE,
+                      (tileCount.y + TILED_MAP_CHUNK_SIZE - 1) / TILED_MAP_CHUNK_SIZE)
+        , mChunkSize(tileSize * static_cast<float>(TILED_MAP_CHUNK_SIZE))
+        , mChunks(mChunkCount.x * mChunkCount.y)
+    { }
+
+    void AddTile(uint32_t x, uint32_t y, const sf::Texture* texture, const sf::Vector2f& position, 
+                 const sf::Vector2f& size, const sf::IntRect& textureRegion)
+    {
+        uint32_t chunkX = x / TILED_MAP_CHUNK_SIZE;
+        uint32_t chunkY = y / TILED_MAP_CHUNK_SIZE;
+        mChunks[chunkY * mChunkCount.x + chunkX].AddTile(texture, position, size, textureRegion);
+
+        // Tiles larger than the grid spill into neighbouring chunk cells
+        mOverhang.x = std::max(mOverhang.x, std::abs(size.x) - mChunkSize.x / TILED_MAP_CHUNK_SIZE);
+        mOverhang.y = std::max(mOverhang.y, std::abs(size.y) - mChunkSize.y / TILED_MAP_CHUNK_SIZE);
+    }
+
+    void Draw(sf::RenderTarget& target, const sf::FloatRect& region) const
+    {
+        ForEachChunk(region, [&target](const TiledMapTileChunk& chunk)
+        {
+            chunk.Draw(target);
+            return true;
+        });
+    }
+
+    bool HasContent(const sf::FloatRect& region) const
+    {
+        bool hasContent = false;
+        ForEachChunk(region, [&hasContent](const TiledMapTileChunk& chunk)
+        {
+            hasContent = true;
+            return false;
+        });
+        return hasContent;
+    }
+
+private:
+    // Visits non-empty chunks overlapping the region until the callback returns false
+    template<typename Callback>
+    void ForEachChunk(const sf::FloatRect& region, Callback callback) const
+    {
+        if (mChunks.empty())
+        {
+            return;
+        }
+
+        // Only visit the chunk cells covered by the region
+        int32_t firstX = static_cast<int32_t>(std::floor((region.left - mOverhang.x) / mChunkSize.x));
+        int32_t firstY = static_cast<int32_t>(std::floor((region.top - mOverhang.y) / mChunkSize.y));
+        int32_t lastX = static_cast<int32_t>(std::floor((region.left + region.width) / mChunkSize.x));
+        int32_t lastY = static_cast<int32_t>(std::floor((region.top + region.height) / mChunkSize.y));
+
+        firstX = std::max(firstX, 0);
+        firstY = std::max(firstY, 0);
+        lastX = std::min(lastX, static_cast<int32_t>(mChunkCount.x) - 1);
+        lastY = std::min(lastY, static_cast<int32_t>(mChunkCount.y) - 1);
+
+        for (int32_t y = firstY; y <= lastY; y++)
+        {
+            for (int32_t x = firstX; x <= lastX; x++)
+            {
+                const TiledMapTileChunk& chunk = mChunks[y * mChunkCount.x + x];
+                if (!chunk.IsEmpty() && chunk.GetBounds().findIntersection(region) && !callback(chunk))
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+    sf::Vector2u mChunkCount;
+    sf::Vector2f mChunkSize;
+    sf::Vector2f mOverhang;
+    std::vector<TiledMapTileChunk> mChunks;
+};
+
 //------------------------------------------------------------------------------
 class TiledMapRenderer
 {
@@ -383,6 +1041,7 @@ public:
         : mTiledMap(tiledMap)
     { 
         mTiledMap.LoadTextures();
+        BuildTileLayerMeshes();
     }
     
     ~TiledMapRenderer()
@@ -404,42 +1063,73 @@ public:
     }
 
     void Draw(sf::RenderTarget& window, const TiledMapLayer& layer)
+    {
+        Draw(window, layer, GetViewBounds(window.getView()));
+    }
+
+    void Draw(sf::RenderTarget& window, const TiledMapLayer& layer, const sf::FloatRect& region)
     {
         if (layer.GetType() == TiledMapLayerType::TileLayer)
         {
-            DrawTileLayer(window, layer);
+            DrawTileLayer(window, layer, region);
         }
         else if (layer.GetType() == TiledMapLayerType::ObjectGroup)
         {
             DrawObjectGroup(window, layer);
         }
     }
+
+    bool HasContent(const TiledMapLayer& layer, const sf::FloatRect& region) const
+    {
+        auto itr = mTileLayerMeshes.find(&layer);
+        return itr != mTileLayerMeshes.end() && itr->second.HasContent(region);
+    }
     
 private:
-    void DrawTileLayer(sf::RenderTarget& window, const TiledMapLayer& layer)
+    void BuildTileLayerMeshes()
     {
         sf::Vector2f tileSize = mTiledMap.GetTileSize();
 
-        for (uint32_t y = 0; y < layer.GetTileCount().y; y++)
+        for (const TiledMapLayer& layer : mTiledMap.GetLayers())
         {
-            for (uint32_t x = 0; x < layer.GetTileCount().x; x++)
+            if (layer.GetType() != TiledMapLayerType::TileLayer)
             {
-                const TiledMapTile* tile = layer.GetTile(x, y);
+                continue;
+            }
+
+            TiledMapTileLayerMesh& mesh = mTileLayerMeshes.emplace(&layer, TiledMapTileLayerMesh(layer.GetTileCount(), tileSize)).first->second;
 
-                if (tile != nullptr)
+            for (uint32_t y = 0; y < layer.GetTileCount().y; y++)
+            {
+                for (uint32_t x = 0; x < layer.GetTileCount().x; x++)
                 {
-                    sf::Texture* texture = mTiledMap.GetTetxure(tile->GetGid());
-                    sf::Sprite sprite(*texture);
-                    sprite.setTextureRect(tile->GetTextureRegion());
-                    sprite.setPosition({ x * tileSize.x, y * tileSize.y });
-                    sprite.setScale(tile->GetScale());
+                    uint32_t gid = layer.GetTileGid(x, y);
+
+                    if (gid != 0)
+                    {
+                        const TiledMapTile* tile = mTiledMap.GetTile(gid);
+                        const sf::IntRect& textureRegion = mTiledMap.GetTextureRegion(gid);
+
+                        sf::Vector2f size(textureRegion.getSize());
+                        size.x *= tile->GetScale().x;
+                        size.y *= tile->GetScale().y;
 
-                    window.draw(sprite);
+                        mesh.AddTile(x, y,
+                                     mTiledMap.GetTetxure(gid),
+                                     { x * tileSize.x, y * tileSize.y },
+                                     size,
+                                     textureRegion);
+                    }
                 }
             }
         }
     }
 
+    void DrawTileLayer(sf::RenderTarget& window, const TiledMapLayer& layer, const sf::FloatRect& region)
+    {
+        mTileLayerMeshes.at(&layer).Draw(window, region);
+    }
+
     void DrawObjectGroup(sf::RenderTarget& window, const TiledMapLayer& layer)
     {
         for (const TiledMapObject& object : layer.GetObjects())
@@ -448,7 +1138,7 @@ private:
             {
                 sf::Texture* texture = mTiledMap.GetTetxure(object.GetGid());
                 sf::Sprite sprite(*texture);
-                sprite.setTextureRect(object.GetTextureRegion());
+                sprite.setTextureRect(mTiledMap.GetTextureRegion(object.GetGid()));
                 sprite.setPosition(object.GetPosition());
                 sprite.setScale(object.GetScale());
 
@@ -458,4 +1148,94 @@ private:
     }
 
     TiledMap& mTiledMap;
+    std::unordered_map<const TiledMapLayer*, TiledMapTileLayerMesh> mTileLayerMeshes;
+};
+
+//------------------------------------------------------------------------------
+class TiledMapPageCache
+{
+    struct Page
+    {
+        sf::FloatRect mBounds;
+        std::unique_ptr<sf::RenderTexture> mTexture;
+    };
+
+public:
+    // Pre-renders static tile layers into fixed-size render texture pages
+    TiledMapPageCache(TiledMapRenderer& renderer, const std::vector<const TiledMapLayer*>& layers, 
+                      const sf::Vector2f& mapSize, uint32_t pageSize = 1024)
+        : mPageCount(static_cast<uint32_t>(std::ceil(mapSize.x / pageSize)),
+                     static_cast<uint32_t>(std::ceil(mapSize.y / pageSize)))
+        , mPageSize(static_cast<float>(pageSize))
+        , mPages(mPageCount.x * mPageCount.y)
+    {
+        for (uint32_t y = 0; y < mPageCount.y; y++)
+        {
+            for (uint32_t x = 0; x < mPageCount.x; x++)
+            {
+                Page& page = mPages[y * mPageCount.x + x];
+                page.mBounds = sf::FloatRect({ x * mPageSize, y * mPageSize }, { mPageSize, mPageSize });
+
+                bool hasContent = std::any_of(layers.begin(), layers.end(), [&](const TiledMapLayer* layer)
+                {
+                    return renderer.HasContent(*layer, page.mBounds);
+                });
+
+                // Empty pages keep no texture
+                if (!hasContent)
+                {
+                    continue;
+                }
+
+                page.mTexture = std::make_unique<sf::RenderTexture>();
+                if (!page.mTexture->create({ pageSize, pageSize }))
+                {
+                    throw std::runtime_error("Failed to create tiled map page texture");
+                }
+
+                page.mTexture->clear(sf::Color::Transparent);
+                page.mTexture->setView(sf::View(page.mBounds));
+                for (const TiledMapLayer* layer : layers)
+                {
+                    renderer.Draw(*page.mTexture, *layer, page.mBounds);
+                }
+                page.mTexture->display();
+            }
+        }
+    }
+
+    void Draw(sf::RenderTarget& target, const sf::FloatRect& region) const
+    {
+        if (mPages.empty())
+        {
+            return;
+        }
+
+        int32_t firstX = std::max(static_cast<int32_t>(std::floor(region.left / mPageSize)), 0);
+        int32_t firstY = std::max(static_cast<int32_t>(std::floor(region.top / mPageSize)), 0);
+        int32_t lastX = std::min(static_cast<int32_t>(std::floor((region.left + region.width) / mPageSize)), 
+                                 static_cast<int32_t>(mPageCount.x) - 1);
+        int32_t lastY = std::min(static_cast<int32_t>(std::floor((region.top + region.height) / mPageSize)), 
+                                 static_cast<int32_t>(mPageCount.y) - 1);
+
+        for (int32_t y = firstY; y <= lastY; y++)
+        {
+            for (int32_t x = firstX; x <= lastX; x++)
+            {
+                const Page& page = mPages[y * mPageCount.x + x];
+                if (page.mTexture)
+                {
+                    // One textured quad per page
+                    sf::Sprite sprite(page.mTexture->getTexture());
+                    sprite.setPosition(page.mBounds.getPosition());
+                    target.draw(sprite);
+                }
+            }
+        }
+    }
+
+private:
+    sf::Vector2u mPageCount;
+    float mPageSize;
+    std::vector<Page> mPages;
 };
\ No newline at end of file
@@ -12,21 +12,25 @@ public:
     virtual void Move(const sf::Vector2f& offset)
     {
         mTransformable.move(offset);
+        InvalidateBounds();
     }
 
     virtual void SetPosition(const sf::Vector2f& position)
     {
         mTransformable.setPosition(position);        
+        InvalidateBounds();
     }
     
     void SetOrigin(const sf::Vector2f& origin)
     {
         mTransformable.setOrigin(origin);
+        InvalidateBounds();
     }
 
     void SetScale(const sf::Vector2f& factors)
     {
         mTransformable.setScale(factors);
+        InvalidateBounds();
     }
 
     const sf::Vector2f& GetPosition() const
@@ -41,9 +45,17 @@ public:
 
     sf::Transformable& GetInternaleTransformable()
     {
+        // Caller may change the transform directly
+        InvalidateBounds();
         return mTransformable;
     }
 
+protected:
+    void InvalidateBounds() { mIsBoundsDirty = true; }
+
+    // World bounds derived from the transform are cached by the owner until the next change
+    mutable bool mIsBoundsDirty = true;
+
 private:
     sf::Transformable mTransformable;
 };
\ No newline at end of file
@@ -0,0 +1,130 @@
+// Includes
+//------------------------------------------------------------------------------
+// Core
+#include "TriggerSystem.h"
+#include "GameObject.h"
+
+// System
+#include <algorithm>
+
+//------------------------------------------------------------------------------
+TriggerSystem::TriggerSystem(float cellSize)
+    : mSensorHash(cellSize)
+{
+}
+
+//------------------------------------------------------------------------------
+void TriggerSystem::AddSensor(GameObject* owner, const FloatRect& region, TriggerCallback callback)
+{
+    mSensors[owner] = std::move(callback);
+    mSensorHash.Insert(owner, region);
+}
+
+//------------------------------------------------------------------------------
+void TriggerSystem::MoveSensor(GameObject* owner, const FloatRect& region)
+{
+    mSensorHash.Update(owner, region);
+}
+
+//------------------------------------------------------------------------------
+void TriggerSystem::RemoveSensor(GameObject* owner)
+{
+    mSensors.erase(owner);
+    mSensorHash.Remove(owner);
+}
+
+//------------------------------------------------------------------------------
+void TriggerSystem::AddBody(GameObject* body)
+{
+    auto itr = std::find_if(mBodies.begin(), mBodies.end(), [body](const Body& entry) { return entry.mObject == body; });
+    if (itr == mBodies.end())
+    {
+        mBodies.push_back({ body, {} });
+    }
+}
+
+//------------------------------------------------------------------------------
+void TriggerSystem::RemoveBody(GameObject* body)
+{
+    auto itr = std::find_if(mBodies.begin(), mBodies.end(), [body](const Body& entry) { return entry.mObject == body; });
+    if (itr == mBodies.end())
+    {
+        return;
+    }
+
+    for (GameObject* owner : itr->mOverlaps)
+    {
+        Notify(owner, TriggerEventType::EXIT, body);
+    }
+    mBodies.erase(itr);
+}
+
+//------------------------------------------------------------------------------
+void TriggerSystem::Update()
+{
+    RemoveKilledSensors();
+
+    for (size_t index = 0; index < mBodies.size(); )
+    {
+        GameObject* body = mBodies[index].mObject;
+        if (body->IsMarkedForRemoval())
+        {
+            RemoveBody(body);
+            continue;
+        }
+
+        std::vector<GameObject*> previousOverlaps = std::move(mBodies[index].mOverlaps);
+        mOverlaps.clear();
+        mSensorHash.QueryAABB(body->GetHitbox(), mOverlaps);
+
+        // Sensors are looked up per notification so callbacks may add or remove them
+        for (GameObject* owner : previousOverlaps)
+        {
+            if (std::find(mOverlaps.begin(), mOverlaps.end(), owner) == mOverlaps.end())
+            {
+                Notify(owner, TriggerEventType::EXIT, body);
+            }
+        }
+        for (GameObject* owner : mOverlaps)
+        {
+            bool wasInside = std::find(previousOverlaps.begin(), previousOverlaps.end(), owner) != previousOverlaps.end();
+            Notify(owner, wasInside ? TriggerEventType::STAY : TriggerEventType::ENTER, body);
+        }
+
+        mBodies[index].mOverlaps = mOverlaps;
+        index++;
+    }
+}
+
+//------------------------------------------------------------------------------
+void TriggerSystem::Notify(GameObject* owner, TriggerEventType type, GameObject* body)
+{
+    auto itr = mSensors.find(owner);
+    if (itr != mSensors.end() && itr->second)
+    {
+        itr->second(type, body);
+    }
+}
+
+//------------------------------------------------------------------------------
+void TriggerSystem::RemoveKilledSensors()
+{
+    // Killed owners are dropped before their memory is released by the object manager
+    for (auto itr = mSensors.begin(); itr != mSensors.end(); )
+    {
+        if (itr->first->IsMarkedForRemoval())
+        {
+            GameObject* owner = itr->first;
+            mSensorHash.Remove(owner);
+            for (Body& body : mBodies)
+            {
+                body.mOverlaps.erase(std::remove(body.mOverlaps.begin(), body.mOverlaps.end(), owner), body.mOverlaps.end());
+            }
+            itr = mSensors.erase(itr);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+}
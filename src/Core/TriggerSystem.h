@@ -0,0 +1,60 @@
+#pragma once
+
+// Includes
+//------------------------------------------------------------------------------
+// Core
+#include "FloatRect.h"
+#include "SpatialHash.h"
+
+// System
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// Forward declarations
+//------------------------------------------------------------------------------
+class GameObject;
+
+//------------------------------------------------------------------------------
+enum class TriggerEventType : uint32_t
+{
+    ENTER = 0,
+    STAY,
+    EXIT
+};
+
+using TriggerCallback = std::function<void(TriggerEventType type, GameObject* body)>;
+
+//------------------------------------------------------------------------------
+class TriggerSystem
+{
+    struct Body
+    {
+        GameObject* mObject;
+        std::vector<GameObject*> mOverlaps;
+    };
+
+public:
+    explicit TriggerSystem(float cellSize);
+
+    // Each owner registers at most one sensor region
+    void AddSensor(GameObject* owner, const FloatRect& region, TriggerCallback callback);
+    void MoveSensor(GameObject* owner, const FloatRect& region);
+    void RemoveSensor(GameObject* owner);
+
+    // Bodies are tested against sensors every update, e.g. the player
+    void AddBody(GameObject* body);
+    void RemoveBody(GameObject* body);
+
+    // Reports enter, stay and exit transitions since the previous update
+    void Update();
+
+private:
+    void Notify(GameObject* owner, TriggerEventType type, GameObject* body);
+    void RemoveKilledSensors();
+
+    SpatialHash mSensorHash;
+    std::unordered_map<GameObject*, TriggerCallback> mSensors;
+    std::vector<Body> mBodies;
+    std::vector<GameObject*> mOverlaps;
+};
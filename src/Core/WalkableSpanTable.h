@@ -0,0 +1,86 @@
+#pragma once
+
+// Includes
+//------------------------------------------------------------------------------
+// Third party
+#include <SFML/Graphics.hpp>
+
+// System
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+//------------------------------------------------------------------------------
+struct WalkableSpan
+{
+    float mLeft;
+    float mRight;
+    float mTop;
+};
+
+//------------------------------------------------------------------------------
+class WalkableSpanTable
+{
+public:
+    WalkableSpanTable() = default;
+
+    // A span is a run of solid cells with open space directly above, it ends at drops and walls
+    WalkableSpanTable(const std::vector<bool>& solidMask, const sf::Vector2u& gridSize, const sf::Vector2f& tileSize)
+        : mTileSize(tileSize)
+        , mRows(gridSize.y)
+    {
+        auto isSolid = [&](uint32_t x, uint32_t y) { return solidMask[y * gridSize.x + x]; };
+
+        for (uint32_t y = 0; y < gridSize.y; y++)
+        {
+            uint32_t x = 0;
+            while (x < gridSize.x)
+            {
+                auto isSurface = [&](uint32_t column) { return isSolid(column, y) && (y == 0 || !isSolid(column, y - 1)); };
+                if (!isSurface(x))
+                {
+                    x++;
+                    continue;
+                }
+
+                uint32_t first = x;
+                while (x < gridSize.x && isSurface(x))
+                {
+                    x++;
+                }
+                mRows[y].push_back({ first * tileSize.x, x * tileSize.x, y * tileSize.y });
+            }
+        }
+    }
+
+    // Finds the span whose surface cell contains the point, e.g. one pixel below an enemy's feet
+    std::optional<WalkableSpan> FindSpan(const sf::Vector2f& point) const
+    {
+        if (point.x < 0.0f || point.y < 0.0f || mRows.empty())
+        {
+            return std::nullopt;
+        }
+
+        size_t row = static_cast<size_t>(point.y / mTileSize.y);
+        if (row >= mRows.size())
+        {
+            return std::nullopt;
+        }
+
+        // Spans in a row are sorted by left edge
+        const std::vector<WalkableSpan>& spans = mRows[row];
+        auto itr = std::upper_bound(spans.begin(), spans.end(), point.x, [](float x, const WalkableSpan& span)
+        {
+            return x < span.mLeft;
+        });
+        if (itr == spans.begin() || point.x >= std::prev(itr)->mRight)
+        {
+            return std::nullopt;
+        }
+        return *std::prev(itr);
+    }
+
+private:
+    sf::Vector2f mTileSize;
+    std::vector<std::vector<WalkableSpan>> mRows;
+};
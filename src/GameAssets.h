@@ -7,6 +7,7 @@
 
 // Core
 #include "Core/ResourceManager.h"
+#include "Core/Bitmask.h"
 
 //------------------------------------------------------------------------------
 class GameAssets
@@ -40,12 +41,17 @@ public:
         {
             locator.GetTextureVectorManager().RequireResource(filepath);
         }
+
+        PreloadCollisionMasks();
     }
 
     void UnloadGlobalAssets()
     {
         ResourceLocator& locator = ResourceLocator::GetInstance();
 
+        // Masks are keyed by texture address, which later loads may reuse
+        BitmaskCache::Instance().Clear();
+
         for (auto& [_, filepath] : FONT_MAP)
         {
             locator.GetFontManager().ReleaseResource(filepath);
@@ -98,6 +104,39 @@ public:
     }
 
 private:
+    void PreloadCollisionMasks()
+    {
+        // Frames of the player and of damage sprites are the ones pixel tested during gameplay
+        auto preload = [](const sf::Texture& texture)
+        {
+            BitmaskCache::Instance().Preload(texture, sf::IntRect({ 0, 0 }, sf::Vector2i(texture.getSize())));
+        };
+
+        for (const char* id : { "spike", "pearl" })
+        {
+            preload(GetTexture(id));
+        }
+
+        for (const char* id : { "saw", "floor_spike", "tooth" })
+        {
+            for (const std::unique_ptr<sf::Texture>& texture : GetTextureVec(id))
+            {
+                preload(*texture);
+            }
+        }
+
+        for (const char* id : { "player", "shell" })
+        {
+            for (const auto& [_, textures] : GetTextureDirMap(id))
+            {
+                for (const std::unique_ptr<sf::Texture>& texture : textures)
+                {
+                    preload(*texture);
+                }
+            }
+        }
+    }
+
     static AssetLookup& GetTextureLookup()
     {
         static AssetLookup lookup = {
@@ -13,6 +13,7 @@
 
 // Core
 #include "Core/GameObjectManager.h"
+#include "Core/DrawList.h"
 #include "Core/StringUtils.h"
 #include "Core/RandomUtils.h"
 #include "Core/DrawUtils.h"
@@ -29,7 +30,12 @@ public:
         , mGameView(gameView)
         , mHudView(hudView)        
         , mPlayer(nullptr)
+        , mTriggerSystem(TRIGGER_CELL_SIZE)
+        , mActivationMargin(ACTIVATION_MARGIN)
+        , mDrawLists(GetSortedDepths().back() + 1)
     {
+        mCollisionSprites.EnableSpatialHash(COLLISION_CELL_SIZE);
+        mSemiCollisionSprites.EnableSpatialHash(COLLISION_CELL_SIZE);
         Setup();
     }
 
@@ -50,9 +56,14 @@ public:
 
     bool Update(const sf::Time& timeslice)
     {
-        for (GameObject* object : mAllSprites)
+        // Objects further than the margin from the view sleep unless their policy opts out
+        sf::FloatRect activeRegion = InflateRect(GetViewBounds(mGameView), mActivationMargin * 2.0f, mActivationMargin * 2.0f);
+        mAllSprites.Update(timeslice, FloatRect(activeRegion));
+        mTriggerSystem.Update();
+
+        for (DrawList<DrawOrder>& drawList : mDrawLists)
         {
-            object->Update(timeslice);
+            drawList.Refresh();
         }
                 
         mGameView.setCenter(mPlayer->GetCameraCenter());
@@ -60,6 +71,9 @@ public:
         return true;
     }
 
+    // Distance around the game view inside which objects are simulated
+    void SetActivationMargin(float margin) { mActivationMargin = margin; }
+
     bool Draw(sf::RenderWindow& window)
     {
         DrawGame(window);
@@ -75,10 +89,10 @@ public:
         {
             mLevelMap.Draw(window, depth);
 
-            for (const GameObject* object : mDrawGroups[depth])
+            mDrawLists[depth].ForEach([&window](const GameObject* object)
             {
                 window.draw(*object);
-            }
+            });
         }
 
         for (GameObject* object : mAllSprites)
@@ -106,7 +120,6 @@ private:
     void Setup()
     {
         CreatePlayer();
-        CreateTileObjects();
         CreateBackgroundDetail();
         CreateStaticObjects();
         CreateMovingObjects();
@@ -124,31 +137,16 @@ private:
                 GameObjectManager& gameObjectManager = GameObjectManager::Instance();
                 mPlayer = gameObjectManager.CreateGameObject<Player>(object.GetPosition(),
                                                                      mGameAssets.GetTextureDirMap("player"),
+                                                                     mLevelMap.GetCollisionGrid(),
                                                                      mCollisionSprites,
                                                                      mSemiCollisionSprites,
                                                                      mGameData);
                 AddToCommonGroups(mPlayer);
+                mTriggerSystem.AddBody(mPlayer);
             }
         }
     }
 
-    void CreateTileObjects()
-    {        
-        sf::Vector2f tileSize = mLevelMap.GetTileSize();
-        for (const auto& [coord, tile] : mLevelMap.GetTileDataByLayerName("Terrain"))
-        {
-            int32_t coordX = std::get<0>(coord);
-            int32_t coordY = std::get<1>(coord);            
-            
-            Sprite* sprite = CreateGameObject<Sprite>(mLevelMap.GetTexture(tile->GetGid()),
-                                                      tile->GetTextureRegion(),
-                                                      sf::Vector2f(coordX * tileSize.x, coordY * tileSize.y),
-                                                      0);  // TODO: fix depth
-            mAllSprites.AddGameObject(sprite);
-            mCollisionSprites.AddGameObject(sprite);
-        }
-    }
-
     void CreateBackgroundDetail()
     {
         for (const TiledMapObject& object : mLevelMap.GetObjectsByLayerName("BG details"))
@@ -157,6 +155,7 @@ private:
             if (object.GetName() == "static")
             {
                 GameObject* sprite = CreateGameObject<Sprite>(mLevelMap.GetTexture(object.GetGid()), 
+                                                              mLevelMap.GetTextureRegion(object.GetGid()),
                                                               object.GetPosition(), 
                                                               DEPTHS.at("bg tiles"));
                 AddToCommonGroups(sprite);
@@ -188,6 +187,7 @@ private:
             if (object.GetName() == "barrel" || object.GetName() == "crate")
             {
                 GameObject* sprite = CreateGameObject<Sprite>(mLevelMap.GetTexture(object.GetGid()), 
+                                                              mLevelMap.GetTextureRegion(object.GetGid()),
                                                               object.GetPosition(), 
                                                               DEPTHS.at("main"));
                 AddToCommonGroups(sprite);
@@ -337,6 +337,8 @@ private:
                                                              object.GetScale(),
                                                              mGameAssets.GetTextureVec(object.GetName()),
                                                              ANIMATION_SPEED,
+                                                             mLevelMap.GetWalkableSpans(),
+                                                             mLevelMap.GetCollisionGrid(),
                                                              mCollisionSprites);                                                                              
                 AddToCommonGroups(sprite);
                 mDemageSprites.AddGameObject(sprite);
@@ -344,7 +346,7 @@ private:
             }
             else if (object.GetName() == "shell")
             {
-                GameObject* sprite = CreateGameObject<Shell>(object.GetPosition(),
+                Shell* sprite = CreateGameObject<Shell>(object.GetPosition(),
                                                              object.GetPropertyValue<bool>("reverse"),
                                                              mGameAssets.GetTextureDirMap(object.GetName()),
                                                              ANIMATION_SPEED,
@@ -352,6 +354,10 @@ private:
                                                              *this);
                 AddToCommonGroups(sprite);
                 mCollisionSprites.AddGameObject(sprite);
+                mTriggerSystem.AddSensor(sprite, sprite->GetFiringZone(), [sprite](TriggerEventType type, GameObject* body)
+                {
+                    sprite->HandleTrigger(type, body);
+                });
             }
         }
     }
@@ -424,7 +430,7 @@ private:
     void AddToCommonGroups(GameObject* sprite)
     {
         mAllSprites.AddGameObject(sprite);
-        mDrawGroups[sprite->GetDepth()].AddGameObject(sprite);
+        mDrawLists[sprite->GetDepth()].Add(sprite);
     }
 
 #pragma endregion
@@ -439,7 +445,6 @@ private:
     sf::View& mHudView;
 
     // Groups
-    std::unordered_map<uint32_t, Group> mDrawGroups;
     Group mAllSprites;
     Group mCollisionSprites;
     Group mSemiCollisionSprites;
@@ -447,4 +452,11 @@ private:
     Group mToothSprites;
     Group mPearlSprites;
     Group mItemSprites;
+
+    TriggerSystem mTriggerSystem;
+    float mActivationMargin;
+
+    // Draw lists indexed by depth
+    using DrawOrder = DrawOrderByInsertion;
+    std::vector<DrawList<DrawOrder>> mDrawLists;
 };
\ No newline at end of file
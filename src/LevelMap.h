@@ -7,6 +7,12 @@
 
 // Core
 #include "Core/TiledMap.h"
+#include "Core/TileCollisionGrid.h"
+#include "Core/TileGridUtils.h"
+#include "Core/WalkableSpanTable.h"
+
+// System
+#include <unordered_set>
 
 //------------------------------------------------------------------------------
 class LevelMap
@@ -14,29 +20,52 @@ class LevelMap
 public:
     LevelMap(fs::path mapFilepath)
         : mIsDrawObjectLayersEnabled(true)
+        , mIsStaticLayerCacheEnabled(true)
     {
         mTiledMap = std::make_unique<TiledMap>(mapFilepath);
-        mTiledMapRenderer = std::make_unique<TiledMapRenderer>(*mTiledMap);
 
         SetDrawObjectLayersEnabled(false);
-        AddDrawabeLayer("BG", DEPTHS.at("bg tiles"));
-        AddDrawabeLayer("FG", DEPTHS.at("bg tiles"));
+        AddDrawabeLayer("BG", DEPTHS.at("bg tiles"), true);
+        AddDrawabeLayer("FG", DEPTHS.at("bg tiles"), true);
         AddDrawabeLayer("Terrain", DEPTHS.at("main"));
         AddDrawabeLayer("Platforms", DEPTHS.at("main"));
+
+        BuildCollisionGrid("Terrain");
+    }
+
+    // Decodes tileset images, safe to call from a worker thread
+    void PrepareTextures()
+    {
+        mTiledMap->PrepareTextures();
+    }
+
+    // Uploads textures and builds render meshes, must run on the main thread
+    void LoadTextures()
+    {
+        mTiledMapRenderer = std::make_unique<TiledMapRenderer>(*mTiledMap);
+        BuildStaticLayerCaches();
+    }
+
+    // Frees the page caches and tile textures, LoadTextures brings them back
+    void UnloadTextures()
+    {
+        mStaticLayerCaches.clear();
+        mTiledMapRenderer.reset();
     }
 
-    const std::map<std::tuple<int32_t, int32_t>, TiledMapTile*>& GetTileDataByLayerName(std::string layerName) const
+    bool IsTexturesLoaded() const { return mTiledMapRenderer != nullptr; }
+
+    const TiledMapLayer* GetTileLayerByName(std::string layerName) const
     {
         for (const TiledMapLayer& layer : mTiledMap->GetLayers())
         {
-            if (layer.GetName() == layerName)
+            if (layer.GetName() == layerName && layer.GetType() == TiledMapLayerType::TileLayer)
             {
-                return layer.GetTileData();
+                return &layer;
             }
         }
 
-        static const std::map<std::tuple<int32_t, int32_t>, TiledMapTile*> emptyVector{ };
-        return emptyVector;
+        return nullptr;
     }
 
     const std::vector<TiledMapObject>& GetObjectsByLayerName(std::string layerName) const
@@ -53,7 +82,7 @@ public:
         return emptyVector;
     }
 
-    void AddDrawabeLayer(const std::string& layerName, uint32_t depthIndex)
+    void AddDrawabeLayer(const std::string& layerName, uint32_t depthIndex, bool isStatic = false)
     {
         const std::vector<TiledMapLayer>& layers = mTiledMap->GetLayers();
         
@@ -61,7 +90,11 @@ public:
         {
             if (layerName == layers.at(index).GetName())
             {
-                mDrawableLayers[index].push_back(index);
+                mDrawableLayers[depthIndex].push_back(index);
+                if (isStatic)
+                {
+                    mStaticLayers.insert(index);
+                }
                 break;
             }
         }
@@ -70,29 +103,96 @@ public:
     void Draw(sf::RenderWindow& window, uint32_t depth)
     {        
         const std::vector<TiledMapLayer>& layers = mTiledMap->GetLayers();
+        sf::FloatRect viewBounds = GetViewBounds(window.getView());
 
-        for (size_t index : mDrawableLayers[depth])
+        auto cacheItr = mStaticLayerCaches.find(depth);
+        if (mIsStaticLayerCacheEnabled && cacheItr != mStaticLayerCaches.end())
         {
-            const TiledMapLayer& layer = layers[index];
-            if (layer.GetType() == TiledMapLayerType::ObjectGroup)
+            cacheItr->second->Draw(window, viewBounds);
+        }
+        else
+        {
+            // Depths without map layers are left out of the map
+            auto layersItr = mDrawableLayers.find(depth);
+            if (layersItr != mDrawableLayers.end())
             {
-                continue;
+                for (size_t index : layersItr->second)
+                {
+                    const TiledMapLayer& layer = layers[index];
+                    if (layer.GetType() == TiledMapLayerType::ObjectGroup)
+                    {
+                        continue;
+                    }
+                    mTiledMapRenderer->Draw(window, layer, viewBounds);
+                }
             }
-            mTiledMapRenderer->Draw(window, layer);
         }
 
         DebugDraw(window, layers);
     }
 
     const sf::Texture& GetTexture(uint32_t gid) const { return *mTiledMap->GetTetxure(gid); }
+    const sf::IntRect& GetTextureRegion(uint32_t gid) const { return mTiledMap->GetTextureRegion(gid); }
     sf::Vector2f GetTileSize() const { return mTiledMap->GetTileSize(); }
+    const TileCollisionGrid& GetCollisionGrid() const { return mCollisionGrid; }
+    const WalkableSpanTable& GetWalkableSpans() const { return mWalkableSpans; }
 
     // Draw object layer control
     bool IsDrawObjectLayersEnabled() const { return mIsDrawObjectLayersEnabled; }
     void SetDrawObjectLayersEnabled(bool flag) { mIsDrawObjectLayersEnabled = flag; }
     void ToggleDrawObjectLayersEnabled() { mIsDrawObjectLayersEnabled = !mIsDrawObjectLayersEnabled; }
 
+    // Static layer cache control
+    bool IsStaticLayerCacheEnabled() const { return mIsStaticLayerCacheEnabled; }
+    void SetStaticLayerCacheEnabled(bool flag) { mIsStaticLayerCacheEnabled = flag; }
+
 private:
+    void BuildCollisionGrid(const std::string& layerName)
+    {
+        const TiledMapLayer* layer = GetTileLayerByName(layerName);
+        if (layer != nullptr)
+        {
+            std::vector<bool> solidMask = CreateSolidMask(layer->GetTileGrid());
+            mCollisionGrid = TileCollisionGrid(solidMask, layer->GetTileCount(), GetTileSize());
+            mWalkableSpans = WalkableSpanTable(solidMask, layer->GetTileCount(), GetTileSize());
+        }
+    }
+
+    // Pre-renders every draw slot whose layers are all static into cached pages
+    void BuildStaticLayerCaches()
+    {
+        mStaticLayerCaches.clear();
+
+        const std::vector<TiledMapLayer>& layers = mTiledMap->GetLayers();
+        sf::Vector2f tileSize = mTiledMap->GetTileSize();
+
+        for (const auto& [depth, layerIndices] : mDrawableLayers)
+        {
+            bool isStatic = !layerIndices.empty() && std::all_of(layerIndices.begin(), layerIndices.end(), [&](uint32_t index)
+            {
+                return mStaticLayers.count(index) && layers[index].GetType() == TiledMapLayerType::TileLayer;
+            });
+
+            if (!isStatic)
+            {
+                continue;
+            }
+
+            std::vector<const TiledMapLayer*> cachedLayers;
+            sf::Vector2f mapSize;
+            for (uint32_t index : layerIndices)
+            {
+                const TiledMapLayer& layer = layers[index];
+                cachedLayers.push_back(&layer);
+                mapSize.x = std::max(mapSize.x, layer.GetTileCount().x * tileSize.x);
+                mapSize.y = std::max(mapSize.y, layer.GetTileCount().y * tileSize.y);
+            }
+
+            mStaticLayerCaches[depth] = std::make_unique<TiledMapPageCache>(*mTiledMapRenderer, cachedLayers, mapSize);
+        }
+    }
+
+
     void DebugDraw(sf::RenderWindow& window, const std::vector<TiledMapLayer>& layers)
     {
         if (mIsDrawObjectLayersEnabled)
@@ -109,6 +209,11 @@ private:
 
     std::unique_ptr<TiledMap> mTiledMap;
     std::unique_ptr<TiledMapRenderer> mTiledMapRenderer;
+    TileCollisionGrid mCollisionGrid;
+    WalkableSpanTable mWalkableSpans;
     std::unordered_map<uint32_t, std::vector<uint32_t>> mDrawableLayers;
+    std::unordered_set<uint32_t> mStaticLayers;
+    std::unordered_map<uint32_t, std::unique_ptr<TiledMapPageCache>> mStaticLayerCaches;
     bool mIsDrawObjectLayersEnabled;
+    bool mIsStaticLayerCacheEnabled;
 };
\ No newline at end of file
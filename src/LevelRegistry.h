@@ -0,0 +1,135 @@
+#pragma once
+
+// Includes
+//------------------------------------------------------------------------------
+// Game
+#include "LevelMap.h"
+
+// System
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------------
+class LevelRegistry
+{
+    struct Entry
+    {
+        fs::path mFilepath;
+        std::unique_ptr<LevelMap> mLevelMap;
+        std::exception_ptr mError;
+        bool mIsParsed = false;
+    };
+
+public:
+    LevelRegistry(const std::vector<fs::path>& mapFilepaths, uint32_t initialIndex)
+        : mIsStopRequested(false)
+    {
+        for (const fs::path& filepath : mapFilepaths)
+        {
+            mEntries.push_back({ filepath });
+        }
+
+        // Only the first level is parsed before the first frame
+        Entry& initialEntry = mEntries.at(initialIndex);
+        initialEntry.mLevelMap = std::make_unique<LevelMap>(initialEntry.mFilepath);
+        initialEntry.mIsParsed = true;
+
+        // Remaining levels are parsed in play order
+        std::vector<uint32_t> pendingIndices;
+        for (uint32_t offset = 1; offset < mEntries.size(); offset++)
+        {
+            pendingIndices.push_back((initialIndex + offset) % mEntries.size());
+        }
+        mWorker = std::thread(&LevelRegistry::ParseLevels, this, std::move(pendingIndices));
+    }
+
+    ~LevelRegistry()
+    {
+        mIsStopRequested = true;
+        if (mWorker.joinable())
+        {
+            mWorker.join();
+        }
+    }
+
+    LevelRegistry(const LevelRegistry&) = delete;
+    LevelRegistry& operator=(const LevelRegistry&) = delete;
+
+    LevelMap& GetLevelMap(uint32_t index)
+    {
+        Entry& entry = mEntries.at(index);
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mParsedCondition.wait(lock, [&entry]() { return entry.mIsParsed; });
+        }
+
+        if (entry.mError)
+        {
+            std::rethrow_exception(entry.mError);
+        }
+
+        // Only the current level keeps its textures and page caches on the GPU
+        if (mCurrentIndex && *mCurrentIndex != index)
+        {
+            mEntries.at(*mCurrentIndex).mLevelMap->UnloadTextures();
+        }
+        mCurrentIndex = index;
+
+        // Texture upload is deferred until the level is first used
+        LevelMap& levelMap = *entry.mLevelMap;
+        if (!levelMap.IsTexturesLoaded())
+        {
+            levelMap.LoadTextures();
+        }
+
+        return levelMap;
+    }
+
+    size_t Count() const { return mEntries.size(); }
+
+private:
+    void ParseLevels(std::vector<uint32_t> indices)
+    {
+        for (uint32_t index : indices)
+        {
+            if (mIsStopRequested)
+            {
+                break;
+            }
+
+            Entry& entry = mEntries[index];
+            std::unique_ptr<LevelMap> levelMap;
+            std::exception_ptr error;
+
+            try
+            {
+                levelMap = std::make_unique<LevelMap>(entry.mFilepath);
+                levelMap->PrepareTextures();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                entry.mLevelMap = std::move(levelMap);
+                entry.mError = error;
+                entry.mIsParsed = true;
+            }
+            mParsedCondition.notify_all();
+        }
+    }
+
+    std::vector<Entry> mEntries;
+    std::optional<uint32_t> mCurrentIndex;
+    std::mutex mMutex;
+    std::condition_variable mParsedCondition;
+    std::atomic<bool> mIsStopRequested;
+    std::thread mWorker;
+};
@@ -8,6 +8,7 @@
 #include "GameAssets.h"
 #include "Interfaces.h"
 #include "LevelMap.h"
+#include "LevelRegistry.h"
 #include "Level.h"
 #include "Player.h"
 
@@ -27,6 +28,13 @@ public:
     Game(LayerStack& layerStack, const sf::Vector2u& windowSize)
         : Layer(layerStack)        
         , mPosition(sf::Vector2f(windowSize) / 2.0f)
+        , mLevelRegistry({ "data/levels/omni.json",
+                           "data/levels/1.json",
+                           "data/levels/2.json",
+                           "data/levels/3.json",
+                           "data/levels/4.json",
+                           "data/levels/5.json" }, 
+                         mGameData.GetCurrentLevel())
     {        
         mGameAssets.LoadGlobalAssets();
 
@@ -34,14 +42,7 @@ public:
         mGameView.setCenter(sf::Vector2f(windowSize) / 2.0f);
         mHudView = mGameView;
 
-        mLevelMaps.emplace(0, "data/levels/omni.json");
-        mLevelMaps.emplace(1, "data/levels/1.json");
-        mLevelMaps.emplace(2, "data/levels/2.json");
-        mLevelMaps.emplace(3, "data/levels/3.json");
-        mLevelMaps.emplace(4, "data/levels/4.json");
-        mLevelMaps.emplace(5, "data/levels/5.json");
-
-        mCurrentLevel = std::make_unique<Level>(mLevelMaps.at(mGameData.GetCurrentLevel()), mGameData, mGameAssets, *this, mGameView, mHudView);        
+        mCurrentLevel = std::make_unique<Level>(mLevelRegistry.GetLevelMap(mGameData.GetCurrentLevel()), mGameData, mGameAssets, *this, mGameView, mHudView);        
     }
 
     virtual bool HandleEvent(const sf::Event& event) 
@@ -74,19 +75,35 @@ public:
 private:
     virtual void SwitchLevel() override
     {        
-        GameObjectManager::Instance().RemoveAllGameObjects();
-        mCurrentLevelIndex = (mCurrentLevelIndex + 1) % mLevelMaps.size();
-        Level* level = new Level(mLevelMaps.at(mCurrentLevelIndex), mGameData, mGameAssets, *this, mGameView, mHudView);
-        mCurrentLevel.reset(level);
+        // The next level is built first, so a level that fails to load leaves the current one running
+        GameObjectManager& manager = GameObjectManager::Instance();
+        size_t previousObjectCount = manager.Count();
+        uint32_t levelIndex = (mCurrentLevelIndex + 1) % mLevelRegistry.Count();
+
+        std::unique_ptr<Level> level;
+        try
+        {
+            level = std::make_unique<Level>(mLevelRegistry.GetLevelMap(levelIndex), mGameData, mGameAssets, *this, mGameView, mHudView);
+        }
+        catch (...)
+        {
+            manager.DestroyGameObjectsFrom(previousObjectCount);
+            throw;
+        }
+
+        // The level owns every group, dropping it first lets its objects go in bulk without
+        // unlinking each one from its groups
+        mCurrentLevel = std::move(level);
+        manager.DestroyGameObjectsBefore(previousObjectCount);
+        mCurrentLevelIndex = levelIndex;
     }
 
-    Group mAllSprites;
     sf::View mGameView;
     sf::View mHudView;
-    std::unordered_map<uint32_t, LevelMap> mLevelMaps;
     sf::Vector2f mPosition;
     GameData mGameData;
     GameAssets mGameAssets;
+    LevelRegistry mLevelRegistry;
     std::unique_ptr<Level> mCurrentLevel;
     uint32_t mCurrentLevelIndex = 0;
 };
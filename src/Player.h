@@ -7,14 +7,16 @@
 
 // Core
 #include "Core/DrawUtils.h"
+#include "Core/TileCollisionGrid.h"
 
 //------------------------------------------------------------------------------
 class Player : public AnimatedSprite
 {
 public:
-    Player(const sf::Vector2f& position, TextureMap& animFrames, Group& collisionSprites, Group& semiCollisionSprites, 
-           GameData& gameData)
+    Player(const sf::Vector2f& position, TextureMap& animFrames, const TileCollisionGrid& collisionGrid, 
+           Group& collisionSprites, Group& semiCollisionSprites, GameData& gameData)
         : AnimatedSprite(position, { 1.0f, 1.0f }, animFrames["idle"], ANIMATION_SPEED, DEPTHS.at("player"))
+        , mCollisionGrid(collisionGrid)
         , mCollisionSprites(collisionSprites)
         , mSemiCollisionSprites(semiCollisionSprites)
         , mState("idle")
@@ -44,6 +46,7 @@ public:
     }
 
     virtual FloatRect GetHitbox() const override { return mHitbox; }
+    virtual ActivationPolicy GetActivationPolicy() const override { return ActivationPolicy::ALWAYS_ACTIVE; }
     virtual FloatRect GetPreviousHitbox() const override { return mPreviousHitbox; }
 
     virtual void Update(const sf::Time& timeslice)
@@ -101,7 +104,7 @@ public:
         Animate(timeslice);
     };
 
-    sf::Vector2f GetCameraCenter() { return GetGlobalBounds().GetCenter(); }
+    sf::Vector2f GetCameraCenter() { return GetCachedGlobalBounds().GetCenter(); }
 
     virtual void draw(sf::RenderTarget& target, const sf::RenderStates& states) const
     {
@@ -128,30 +131,23 @@ private:
         if (mDirection.y >= 0.0f)
         {
             FloatRect floorCollider = CreateFloorCollider();
+            floorContactDetected = mCollisionGrid.IsOverlapping(floorCollider);
 
-            for (GameObject* object : mCollisionSprites)
+            // Query results already overlap the collider
+            auto detectFloor = [&floorContactDetected](GameObject*, const FloatRect&, const FloatRect&)
             {
-                if (floorContactDetected) { break; }
+                floorContactDetected = true;
+            };
 
-                FloatRect objectHitbox = object->GetHitbox();
-                if (floorCollider.FindIntersection(objectHitbox))
-                {
-                    mSurfaceState["floor"] = true;
-                    floorContactDetected = true;
-                }
+            if (!floorContactDetected)
+            {
+                mCollisionSprites.QueryAABB(floorCollider, detectFloor);
             }
-
-            for (GameObject* object : mSemiCollisionSprites)
+            if (!floorContactDetected)
             {
-                if (floorContactDetected) { break; }
-
-                FloatRect objectHitbox = object->GetHitbox();
-                if (floorCollider.FindIntersection(objectHitbox))
-                {
-                    mSurfaceState["floor"] = true;
-                    floorContactDetected = true;
-                }
+                mSemiCollisionSprites.QueryAABB(floorCollider, detectFloor);
             }
+            mSurfaceState["floor"] = floorContactDetected;
         }
     }
 
@@ -200,35 +196,61 @@ private:
 
     void HortCollision()
     {
-        for (GameObject* object : mCollisionSprites)
+        mCollisionGrid.QueryAABB(mHitbox, [this](const FloatRect& tileHitbox)
+        {
+            if (IsLeftCollision(mHitbox, mPreviousHitbox, tileHitbox, tileHitbox))
+            {
+                mHitbox.SetLeft(tileHitbox.GetRight());
+            }
+            if (IsRightCollision(mHitbox, mPreviousHitbox, tileHitbox, tileHitbox))
+            {
+                mHitbox.SetRight(tileHitbox.GetLeft());
+            }
+        });
+
+        mCollisionSprites.QueryAABB(mHitbox, [this](GameObject*, const FloatRect& objectHitbox, const FloatRect& previousObjectHitbox)
         {
-            FloatRect objectHitbox = object->GetHitbox();
+            // Earlier responses may already have pushed the hitbox clear
             if (mHitbox.FindIntersection(objectHitbox))
             {
-                if (IsLeftCollision(*object))
+                if (IsLeftCollision(mHitbox, mPreviousHitbox, objectHitbox, previousObjectHitbox))
                 {
                     mHitbox.SetLeft(objectHitbox.GetRight());
                 }
-                if (IsRightCollision(*object))
+                if (IsRightCollision(mHitbox, mPreviousHitbox, objectHitbox, previousObjectHitbox))
                 {
                     mHitbox.SetRight(objectHitbox.GetLeft());
                 }
             }
-        }
+        });
     }
 
     void VertCollision()
     {
-        for (GameObject* object : mCollisionSprites)
+        mCollisionGrid.QueryAABB(mHitbox, [this](const FloatRect& tileHitbox)
+        {
+            if (IsUpCollision(mHitbox, mPreviousHitbox, tileHitbox, tileHitbox))
+            {
+                mHitbox.SetTop(tileHitbox.GetBottom());
+            }
+            if (IsDownCollision(mHitbox, mPreviousHitbox, tileHitbox, tileHitbox))
+            {
+                mHitbox.SetBottom(tileHitbox.GetTop());
+            }
+
+            // Prevent velocity from accumulating and player falling through floor
+            mDirection.y = 0.0f;
+        });
+
+        mCollisionSprites.QueryAABB(mHitbox, [this](GameObject*, const FloatRect& objectHitbox, const FloatRect& previousObjectHitbox)
         {
-            FloatRect objectHitbox = object->GetHitbox();
             if (mHitbox.FindIntersection(objectHitbox))
             {
-                if (IsUpCollision(*object))
+                if (IsUpCollision(mHitbox, mPreviousHitbox, objectHitbox, previousObjectHitbox))
                 {
                     mHitbox.SetTop(objectHitbox.GetBottom());
                 }
-                if (IsDownCollision(*object))
+                if (IsDownCollision(mHitbox, mPreviousHitbox, objectHitbox, previousObjectHitbox))
                 {
                     mHitbox.SetBottom(objectHitbox.GetTop());
                 }
@@ -236,11 +258,12 @@ private:
                 // Prevent velocity from accumulating and player falling through floor
                 mDirection.y = 0.0f;
             }
-        }
+        });
     }
 
     FloatRect mHitbox;
     FloatRect mPreviousHitbox;
+    const TileCollisionGrid& mCollisionGrid;
     Group& mCollisionSprites;
     Group& mSemiCollisionSprites;
     std::string mState;
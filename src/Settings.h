@@ -15,6 +15,9 @@ enum class FontId : uint32_t
 constexpr uint32_t WINDOW_WIDTH = 800;
 constexpr uint32_t WINDOW_HEIGHT = 600;
 constexpr uint32_t ANIMATION_SPEED = 6;
+constexpr float COLLISION_CELL_SIZE = 128.0f;
+constexpr float TRIGGER_CELL_SIZE = 512.0f;
+constexpr float ACTIVATION_MARGIN = 400.0f;
 
 extern std::unordered_map<FontId, std::string> FONT_MAP;
 extern std::unordered_map<std::string, uint32_t> DEPTHS;
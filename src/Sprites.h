@@ -5,6 +5,14 @@
 // Game
 #include "BaseSprites.h"
 
+// Core
+#include "Core/WalkableSpanTable.h"
+#include "Core/TileCollisionGrid.h"
+#include "Core/TriggerSystem.h"
+
+// System
+#include <limits>
+
 //------------------------------------------------------------------------------
 class AnimatedSpriteImpl : public AnimatedSprite
 {
@@ -77,6 +85,7 @@ private:
         float x = mCenter.x + std::cos(sf::degrees(mAngle).asRadians()) * mRadius;
         float y = mCenter.y + std::sin(sf::degrees(mAngle).asRadians()) * mRadius;
         SetPosition({ x, y });
+        NotifyHitboxChanged();
     }
 
     sf::Sprite mSprite;
@@ -105,10 +114,16 @@ public:
         mTimer.Start();
     }
 
+    virtual bool IsUpdatable() const override { return true; }
+
+    // Would never expire while asleep
+    virtual ActivationPolicy GetActivationPolicy() const override { return ActivationPolicy::ALWAYS_ACTIVE; }
+
     virtual void Update(const sf::Time& timeslice)
     {        
         float delta = mDirection * mSpeed * timeslice.asSeconds();        
         Move({ delta, 0.0f });
+        NotifyHitboxChanged();
 
         mTimer.Update(timeslice);
         if (mTimer.IsFinished()) { Kill(); }
@@ -133,6 +148,7 @@ public:
         , mBulletDirection(isReverse ? -1.0f : 1.0f)
         , mShootTimer(sf::milliseconds(3000))
         , mHasFired(false)
+        , mIsPlayerInZone(false)
     {
         mShootTimer.Start();
 
@@ -143,18 +159,26 @@ public:
         SetAnimationSequence(mState);
     }
 
-    virtual void Update(const sf::Time& timeslice)
+    // Keeps firing at an approaching player even from off screen
+    virtual ActivationPolicy GetActivationPolicy() const override { return ActivationPolicy::ALWAYS_ACTIVE; }
+
+    // Square around the firing range, the exact distance is checked once the player is inside
+    FloatRect GetFiringZone() const
     {
-        mShootTimer.Update(timeslice);
+        sf::Vector2f center = GetCachedGlobalBounds().GetCenter();
+        return FloatRect(center - sf::Vector2f(FIRING_RANGE, FIRING_RANGE), sf::Vector2f(FIRING_RANGE, FIRING_RANGE) * 2.0f);
+    }
 
-        sf::Vector2f playerPos = mPlayer.GetGlobalBounds().GetCenter();
-        sf::Vector2f shellPos = GetGlobalBounds().GetCenter();
+    void HandleTrigger(TriggerEventType type, GameObject* body)
+    {
+        mIsPlayerInZone = body == &mPlayer && type != TriggerEventType::EXIT;
+    }
 
-        bool isPlayerFront = (mBulletDirection > 0.0f) ? (shellPos.x < playerPos.x) : (shellPos.x > playerPos.x);
-        bool isPlayerNear = (shellPos - playerPos).length() < 500;
-        bool isPlayerLevel = std::abs(shellPos.y - playerPos.y) < 30.0f;
+    virtual void Update(const sf::Time& timeslice)
+    {
+        mShootTimer.Update(timeslice);
 
-        if (isPlayerNear && isPlayerFront && isPlayerLevel && mShootTimer.IsFinished())
+        if (mIsPlayerInZone && mShootTimer.IsFinished() && IsPlayerInSight())
         {
             mState = "fire";
             mShootTimer.Reset(true);
@@ -183,6 +207,20 @@ public:
     }
 
 private:
+    static constexpr float FIRING_RANGE = 500.0f;
+
+    bool IsPlayerInSight() const
+    {
+        sf::Vector2f playerPos = mPlayer.GetCachedGlobalBounds().GetCenter();
+        sf::Vector2f shellPos = GetCachedGlobalBounds().GetCenter();
+
+        bool isPlayerFront = (mBulletDirection > 0.0f) ? (shellPos.x < playerPos.x) : (shellPos.x > playerPos.x);
+        bool isPlayerNear = (shellPos - playerPos).length() < FIRING_RANGE;
+        bool isPlayerLevel = std::abs(shellPos.y - playerPos.y) < 30.0f;
+
+        return isPlayerNear && isPlayerFront && isPlayerLevel;
+    }
+
     bool mIsReverse;
     Player& mPlayer;
     ILevel& mLevelCallbacks;
@@ -190,6 +228,7 @@ private:
     float mBulletDirection;
     Timer mShootTimer;
     bool mHasFired;
+    bool mIsPlayerInZone;
 };
 
 //------------------------------------------------------------------------------
@@ -197,13 +236,27 @@ class Tooth : public AnimatedSpriteImpl
 {
 public:
     Tooth(const sf::Vector2f& position, const sf::Vector2f& scale, TextureVector& animFrames, 
-          uint32_t animSpeed, Group& collisionSprites)
+          uint32_t animSpeed, const WalkableSpanTable& walkableSpans, const TileCollisionGrid& collisionGrid,
+          Group& collisionSprites)
         : AnimatedSpriteImpl(position, scale, animFrames, animSpeed, DEPTHS.at("main"))
+        , mCollisionGrid(collisionGrid)
         , mCollisionSprites(collisionSprites)
         , mDirection(1.0f)
         , mSpeed(200.0f)
+        , mPatrolLeft(std::numeric_limits<float>::lowest())
+        , mPatrolRight(std::numeric_limits<float>::max())
+        , mHasPatrolSpan(false)
     {
         mHitbox = GetGlobalBounds();
+
+        // Terrain limits are fixed for the level, look them up once
+        std::optional<WalkableSpan> span = walkableSpans.FindSpan(mHitbox.GetRectMidBottom() + sf::Vector2f(0.0f, 1.0f));
+        if (span)
+        {
+            mPatrolLeft = span->mLeft;
+            mPatrolRight = span->mRight;
+            mHasPatrolSpan = true;
+        }
     }
 
     virtual FloatRect GetHitbox() const { return mHitbox; }
@@ -224,6 +277,7 @@ public:
 
         UpdateAnimation(timeslice);   
         SetPosition(mHitbox.GetRoundedPosition());
+        NotifyHitboxChanged();
     }
 
 private:
@@ -245,28 +299,42 @@ private:
 
     bool ShouldReverseDir(const sf::Vector2f& floorCollider, const sf::FloatRect& wallCollider) const 
     {        
+        // Drops and terrain walls both end the span, teeth standing off the terrain probe the floor instead
         bool onFloor = false;
+        if (mHasPatrolSpan)
+        {
+            onFloor = mDirection > 0.0f ? mHitbox.GetRight() < mPatrolRight : mHitbox.GetLeft() > mPatrolLeft;
+        }
+        else
+        {
+            onFloor = mCollisionGrid.IsSolid(floorCollider);
+        }
         bool hitWall = false;
 
-        for (GameObject* object : mCollisionSprites)
+        // Crates and barrels are not part of the terrain spans
+        sf::FloatRect queryArea = InflateRect({ mHitbox.GetPosition(), mHitbox.GetSize() }, 4, 4);
+        mCollisionSprites.QueryAABB(queryArea, [&](GameObject*, const FloatRect& objectHitbox, const FloatRect&)
         {
-            if (object->GetHitbox().ContainsPoint(floorCollider))
+            if (objectHitbox.ContainsPoint(floorCollider))
             {
                 onFloor = true;
             }
-            if (object->GetHitbox().FindIntersection(wallCollider))
+            if (objectHitbox.FindIntersection(wallCollider))
             {
                 hitWall = true;
-                break;
             }
-        }
+        });
 
         return hitWall || !onFloor;
     }
 
+    const TileCollisionGrid& mCollisionGrid;
     Group& mCollisionSprites;
     float mDirection;
     float mSpeed;
+    float mPatrolLeft;
+    float mPatrolRight;
+    bool mHasPatrolSpan;
     FloatRect mHitbox;
     sf::FloatRect mTemp;
 };
@@ -366,6 +434,7 @@ public:
 
         sf::Vector2f center = mHitbox.GetCenter();
         SetPosition({ std::round(center.x), std::round(center.y) });
+        NotifyHitboxChanged();
 
         UpdateAnimation(timeslice);
 
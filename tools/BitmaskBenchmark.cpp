@@ -0,0 +1,109 @@
+// Includes
+//------------------------------------------------------------------------------
+// Core
+#include "Core/Bitmask.h"
+#include "Core/SpriteComparisonUtils.h"
+
+// System
+#include <chrono>
+#include <iostream>
+
+//------------------------------------------------------------------------------
+struct BenchmarkCase
+{
+    const char* mName;
+    sf::Vector2f mPosition1;
+    sf::Vector2f mPosition2;
+};
+
+//------------------------------------------------------------------------------
+sf::Image CreateCircleImage(uint32_t size)
+{
+    // Sprite-like mask, an opaque disc with transparent corners
+    sf::Image image;
+    image.create(sf::Vector2u(size, size), sf::Color::Transparent);
+
+    float radius = size / 2.0f;
+    for (uint32_t y = 0; y < size; y++)
+    {
+        for (uint32_t x = 0; x < size; x++)
+        {
+            float dx = x + 0.5f - radius;
+            float dy = y + 0.5f - radius;
+            if (dx * dx + dy * dy <= radius * radius)
+            {
+                image.setPixel(sf::Vector2u(x, y), sf::Color::White);
+            }
+        }
+    }
+    return image;
+}
+
+//------------------------------------------------------------------------------
+template<typename CompareFunc>
+double TimeCompare(CompareFunc compare, uint32_t iterations, uint32_t& hits)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        hits += compare() ? 1 : 0;
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+//------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    // Times the per-pixel transform path against the row path on the same pair of masks
+    const uint32_t spriteSize = 128;
+    const uint32_t iterations = argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 20000;
+
+    sf::Image image = CreateCircleImage(spriteSize);
+    Bitmask bitmask(image, sf::IntRect({ 0, 0 }, { static_cast<int32_t>(spriteSize), static_cast<int32_t>(spriteSize) }));
+
+    // Diagonal neighbours overlap in bounds only, so every pixel of the overlap is visited.
+    // Overlaps narrower than 64 pixels take the per-pixel path on both sides of the comparison
+    const BenchmarkCase cases[] =
+    {
+        { "bounds overlap, no hit", { 0.0f, 0.0f }, { 100.0f, 100.0f } },
+        { "narrow edge hit",        { 0.0f, 0.0f }, { 120.0f, 0.0f } },
+        { "wide edge hit",          { 0.0f, 0.0f }, { 60.0f, 0.0f } },
+        { "deep hit",               { 0.0f, 0.0f }, { 32.0f, 32.0f } },
+    };
+
+    uint32_t hits = 0;
+    for (const BenchmarkCase& benchmarkCase : cases)
+    {
+        sf::Transform transform1;
+        transform1.translate(benchmarkCase.mPosition1);
+        sf::Transform transform2;
+        transform2.translate(benchmarkCase.mPosition2);
+        sf::Transform inverseTransform1 = transform1.getInverse();
+        sf::Transform inverseTransform2 = transform2.getInverse();
+
+        sf::IntRect bounds1(sf::Vector2i(benchmarkCase.mPosition1), sf::Vector2i(spriteSize, spriteSize));
+        sf::IntRect bounds2(sf::Vector2i(benchmarkCase.mPosition2), sf::Vector2i(spriteSize, spriteSize));
+        sf::IntRect compareBounds = bounds1.findIntersection(bounds2).value();
+
+        double transformTime = TimeCompare([&]()
+        {
+            return CompareTransformedPixels(bitmask, bitmask, compareBounds, inverseTransform1, inverseTransform2);
+        }, iterations, hits);
+
+        double rowTime = TimeCompare([&]()
+        {
+            return ComparePixels(bitmask, bitmask, compareBounds, inverseTransform1, inverseTransform2);
+        }, iterations, hits);
+
+        std::cout << benchmarkCase.mName << " (" << compareBounds.width << "x" << compareBounds.height << "): "
+                  << "transform " << transformTime << " ns, "
+                  << "row " << rowTime << " ns, "
+                  << "speedup " << transformTime / rowTime << "x" << std::endl;
+    }
+
+    // Printing the hit count keeps the comparisons from being optimised away
+    std::cout << hits << " hits" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,31 @@
+// Includes
+//------------------------------------------------------------------------------
+// Core
+#include "Core/TiledMap.h"
+
+// System
+#include <iostream>
+
+//------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    // Converts a Tiled JSON map into the binary blob loaded by TiledMap at runtime
+    if (argc != 3)
+    {
+        std::cerr << "Usage: LevelCooker <map.json> <map.cooked>" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        TiledMap tiledMap(fs::absolute(argv[1]), false);
+        tiledMap.SaveCooked(argv[2]);
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << "Failed to cook " << argv[1] << ": " << exception.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}